@@ -0,0 +1,228 @@
+//
+// Timing of funny_iters against standard containers.
+// Usage: bench_app [--csv] [--max-bytes N]   (JSON by default)
+//
+
+#include "bit_iter.h"
+#include "ring_iter.h"
+
+#include <boost/circular_buffer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace funny_it;
+
+namespace
+{
+    struct result
+    {
+        std::string benchmark;
+        std::string variant;
+        size_t bytes;
+        size_t iterations;
+        double ns_per_iteration;
+    };
+
+    std::vector<result> results;
+    size_t volatile sink;
+
+    /*
+     * Repeats op until min_time has passed and records the mean time of one run.
+     * The clock is only read between batches, sized (by doubling, which also warms up) so that one batch
+     * takes at least min_batch_time and the cost of clock::now() vanishes in the mean.
+     */
+    template <class Op>
+    void measure(std::string benchmark, std::string variant, size_t bytes, Op && op)
+    {
+        using clock = std::chrono::steady_clock;
+        auto const min_time = std::chrono::milliseconds(200);
+        auto const min_batch_time = std::chrono::milliseconds(1);
+        auto const run_batch = [&op](size_t batch)
+        {
+            for (size_t i = 0; i < batch; ++i)
+            {
+                sink = op();
+            }
+        };
+
+        size_t batch = 1;
+        for (;;)
+        {
+            auto const batch_start = clock::now();
+            run_batch(batch);
+            if (clock::now() - batch_start >= min_batch_time)
+            {
+                break;
+            }
+            batch *= 2;
+        }
+
+        size_t iterations = 0;
+        auto const start = clock::now();
+        auto elapsed = clock::duration::zero();
+        do
+        {
+            run_batch(batch);
+            iterations += batch;
+            elapsed = clock::now() - start;
+        } while (elapsed < min_time);
+        auto const ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+        results.push_back({std::move(benchmark), std::move(variant), bytes, iterations, ns});
+    }
+
+    /*
+     * 0x55 holds no two adjacent 1 bits (nor across bytes), so the search for "11" only hits the 0xFF in the last byte
+     */
+    template <size_t Bytes>
+    void bench_bit_sequence()
+    {
+        std::vector<std::byte> bytes(Bytes, std::byte{0x55});
+        bytes.back() = std::byte{0xFF};
+        auto const seq = std::make_unique<bit_sequence<Bytes>>(bytes.data());
+
+        measure("bit_count", "bit_sequence", Bytes, [&] { return std::count(seq->begin(), seq->end(), std::byte{1}); });
+        measure("bit_accumulate", "bit_sequence", Bytes, [&] { return std::accumulate(seq->begin(), seq->end(), int(0)); });
+        std::array<std::byte, 2> const pattern {std::byte{1}, std::byte{1}};
+        measure("bit_search", "bit_sequence", Bytes, [&] { return std::search(seq->begin(), seq->end(), pattern.begin(), pattern.end()) - seq->begin(); });
+
+        std::vector<bool> bits;
+        bits.reserve(Bytes * 8);
+        for (auto b : bytes)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                bits.push_back(std::to_integer<int>(b >> i) & 1);
+            }
+        }
+        measure("bit_count", "std::vector<bool>", Bytes, [&] { return std::count(bits.begin(), bits.end(), true); });
+        measure("bit_accumulate", "std::vector<bool>", Bytes, [&] { return std::accumulate(bits.begin(), bits.end(), int(0)); });
+        std::array<bool, 2> const bool_pattern {true, true};
+        measure("bit_search", "std::vector<bool>", Bytes, [&] { return std::search(bits.begin(), bits.end(), bool_pattern.begin(), bool_pattern.end()) - bits.begin(); });
+    }
+
+    constexpr size_t ring_size = 4096;
+    constexpr size_t message_size = 200;
+    constexpr size_t cycles = 1000;
+
+    /*
+     * One cycle: append a '#' terminated message, sum all pending bytes, search for the delimiter, drop the message
+     */
+    template <class E>
+    size_t ring_cycles(char const * message)
+    {
+        static char storage[ring_size];
+        ring_buffer_sequence<char, ring_size, E> rbs (storage);
+        size_t sum = 0;
+        for (size_t i = 0; i < cycles; ++i)
+        {
+            rbs.fill_data(message, message_size);
+            sum += std::accumulate(rbs.begin(), rbs.end(), size_t(0));
+            auto const it = std::find(rbs.begin(), rbs.end(), '#');
+            rbs.align(it + 1);
+        }
+        return sum;
+    }
+
+    template <class Container, class Erase>
+    size_t container_cycles(char const * message, Container & c, Erase && erase_front)
+    {
+        size_t sum = 0;
+        for (size_t i = 0; i < cycles; ++i)
+        {
+            c.insert(c.end(), message, message + message_size);
+            sum += std::accumulate(c.begin(), c.end(), size_t(0));
+            auto const it = std::find(c.begin(), c.end(), '#');
+            erase_front(c, it - c.begin() + 1);
+        }
+        return sum;
+    }
+
+    void bench_ring()
+    {
+        char message[message_size];
+        std::fill(std::begin(message), std::end(message), 'a');
+        message[message_size - 1] = '#';
+        auto const bytes = cycles * message_size;
+
+        measure("ring_cycle", "ring_buffer_sequence<checked>", bytes, [&] { return ring_cycles<exception_checked_variant_type>(message); });
+        measure("ring_cycle", "ring_buffer_sequence<unchecked>", bytes, [&] { return ring_cycles<exception_unchecked_variant_type>(message); });
+        measure("ring_cycle", "std::deque", bytes, [&]
+        {
+            std::deque<char> c;
+            return container_cycles(message, c, [](auto & c, size_t n) { c.erase(c.begin(), c.begin() + n); });
+        });
+        measure("ring_cycle", "std::vector", bytes, [&]
+        {
+            std::vector<char> c;
+            c.reserve(ring_size);
+            return container_cycles(message, c, [](auto & c, size_t n) { c.erase(c.begin(), c.begin() + n); });
+        });
+        measure("ring_cycle", "boost::circular_buffer", bytes, [&]
+        {
+            boost::circular_buffer<char> c (ring_size);
+            return container_cycles(message, c, [](auto & c, size_t n) { c.erase_begin(n); });
+        });
+    }
+
+    template <size_t... Sizes>
+    void bench_bit_sequences(size_t max_bytes, std::index_sequence<Sizes...>)
+    {
+        ((Sizes <= max_bytes ? bench_bit_sequence<Sizes>() : void()), ...);
+    }
+
+    void print_json()
+    {
+        std::cout << "[\n";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            auto const & r = results[i];
+            std::cout << "  {\"benchmark\": \"" << r.benchmark << "\", \"variant\": \"" << r.variant << "\", \"bytes\": " << r.bytes
+                      << ", \"iterations\": " << r.iterations << ", \"ns_per_iteration\": " << r.ns_per_iteration << '}'
+                      << (i + 1 == results.size() ? "\n" : ",\n");
+        }
+        std::cout << "]\n";
+    }
+
+    void print_csv()
+    {
+        std::cout << "benchmark,variant,bytes,iterations,ns_per_iteration\n";
+        for (auto const & r : results)
+        {
+            std::cout << r.benchmark << ',' << r.variant << ',' << r.bytes << ',' << r.iterations << ',' << r.ns_per_iteration << '\n';
+        }
+    }
+}
+
+int main(int argc, char const * argv[])
+{
+    bool csv = false;
+    size_t max_bytes = size_t(256) << 20;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--csv"))
+        {
+            csv = true;
+        } else if (!std::strcmp(argv[i], "--max-bytes") && (i + 1 < argc))
+        {
+            max_bytes = std::stoull(argv[++i]);
+        } else
+        {
+            std::cerr << "usage: " << argv[0] << " [--csv] [--max-bytes N]\n";
+            return 1;
+        }
+    }
+
+    bench_bit_sequences(max_bytes, std::index_sequence<3, size_t(4) << 10, size_t(1) << 20, size_t(16) << 20, size_t(256) << 20>{});
+    bench_ring();
+
+    csv ? print_csv() : print_json();
+    return 0;
+}
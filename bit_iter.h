@@ -1,17 +1,64 @@
 #pragma once
 
 #include <array>
+#include <algorithm>
 #include <cstddef>   // std::byte
+#include <cstdint>
+#include <limits>
+#include <atomic>
 
 namespace funny_it
 {
-    template<size_t Bytes>
+    /**
+     * \brief Snapshot of bit_sequence counters
+     *
+     * Iterators do not report back to their sequence, so what is counted is how often iteration starts,
+     * not how many bits are actually visited.
+     */
+    struct bit_stats
+    {
+        uint64_t begin_calls = 0;
+    };
+
+    /*
+     * Statistics policies: disabled hooks compile to nothing, enabled ones keep relaxed counters.
+     */
+    struct bit_stats_disabled_variant_type
+    {
+        constexpr void on_begin() const noexcept {}
+        [[nodiscard]] constexpr bit_stats snapshot() const noexcept
+        {
+            return {};
+        }
+    };
+
+    class bit_stats_enabled_variant_type
+    {
+        mutable std::atomic<uint64_t> begin_calls_ {0};
+
+    public:
+        bit_stats_enabled_variant_type() = default;
+        bit_stats_enabled_variant_type(bit_stats_enabled_variant_type const &) noexcept {}
+        bit_stats_enabled_variant_type(bit_stats_enabled_variant_type &&) noexcept {}
+
+        void on_begin() const noexcept
+        {
+            begin_calls_.fetch_add(1, std::memory_order_relaxed);
+        }
+        [[nodiscard]] bit_stats snapshot() const noexcept
+        {
+            return {begin_calls_.load(std::memory_order_relaxed)};
+        }
+    };
+
+    template<size_t Bytes, class S>
     class bit_sequence;
 
     template<typename ValueType, size_t Bytes>
     class bit_iterator : public std::iterator<std::bidirectional_iterator_tag, ValueType, ptrdiff_t, void, ValueType> {
     public:
-        friend class bit_sequence<Bytes>;
+        template<size_t, class>
+        friend class bit_sequence;
 
         using class_type = bit_iterator<ValueType, Bytes>;
         using value_type = ValueType;
@@ -114,18 +161,27 @@ namespace funny_it
         }
     };
 
-    template<size_t Bytes>
+    template<size_t Bytes, class S = bit_stats_disabled_variant_type>
     class bit_sequence
     {
         std::array<std::byte, Bytes> arr_;
+        [[no_unique_address]] S stats_;
 
     public:
         explicit bit_sequence(std::array<std::byte, Bytes> arr) : arr_(std::move(arr)){}
+        /*
+         * Copies Bytes bytes, lets large sequences be built in place (on the heap) without a temporary array
+         */
+        explicit bit_sequence(std::byte const * bytes)
+        {
+            std::copy(bytes, bytes + Bytes, std::begin(arr_));
+        }
 
         using const_iterator = bit_iterator<std::byte const, Bytes>;
 
         const_iterator begin() const
         {
+            stats_.on_begin();
             return const_iterator{std::begin(arr_)};
         }
 
@@ -138,6 +194,14 @@ namespace funny_it
         {
             return sizeof(std::byte) * 8 * (std::end(arr_) - std::begin(arr_));
         }
+
+        /**
+         * Counters collected by the S policy (all zero with bit_stats_disabled_variant_type)
+         */
+        [[nodiscard]] bit_stats stats() const noexcept
+        {
+            return stats_.snapshot();
+        }
     };
 }
 
@@ -0,0 +1,297 @@
+#pragma once
+#include "ring_iter.h"
+#include "ring_search.h"
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <algorithm>
+#include <utility>
+#include <string_view>
+#include <vector>
+
+namespace funny_it
+{
+    /**
+     * \brief Fire-and-forget coroutine run by a ring_executor
+     */
+    class ring_task
+    {
+    public:
+        struct promise_type
+        {
+            std::exception_ptr exception_;
+
+            ring_task get_return_object() noexcept
+            {
+                return ring_task {std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+            std::suspend_always final_suspend() noexcept
+            {
+                return {};
+            }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept
+            {
+                exception_ = std::current_exception();
+            }
+        };
+
+        ring_task(ring_task && other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+        ring_task(ring_task const &) = delete;
+        ring_task &operator =(ring_task const &) = delete;
+
+        ~ring_task()
+        {
+            if (handle_)
+            {
+                handle_.destroy();
+            }
+        }
+
+    private:
+        friend class ring_executor;
+
+        std::coroutine_handle<promise_type> handle_;
+
+        explicit ring_task(std::coroutine_handle<promise_type> h) noexcept : handle_(h) {}
+    };
+
+    /**
+     * \brief Single-threaded executor: resumes ready coroutines in FIFO order
+     *
+     * Owns the spawned tasks; the ones still suspended are destroyed with the executor.
+     */
+    class ring_executor
+    {
+        using task_handle = std::coroutine_handle<ring_task::promise_type>;
+
+        std::deque<std::coroutine_handle<>> ready_;
+        std::vector<task_handle> tasks_;
+
+    public:
+        ring_executor() = default;
+        ring_executor(ring_executor const &) = delete;
+        ring_executor &operator =(ring_executor const &) = delete;
+
+        ~ring_executor()
+        {
+            for (auto h : tasks_)
+            {
+                h.destroy();
+            }
+        }
+
+        /**
+         * Takes ownership of the task and schedules its first run
+         */
+        void spawn(ring_task task)
+        {
+            tasks_.push_back(std::exchange(task.handle_, {}));
+            post(tasks_.back());
+        }
+
+        void post(std::coroutine_handle<> h)
+        {
+            ready_.push_back(h);
+        }
+
+        /**
+         * Runs until no coroutine is ready; finished tasks are destroyed and their exceptions rethrown
+         * @return number of resumptions
+         */
+        size_t run()
+        {
+            size_t resumed = 0;
+            while (!ready_.empty())
+            {
+                auto const h = ready_.front();
+                ready_.pop_front();
+                h.resume();
+                ++resumed;
+                if (h.done())
+                {
+                    auto const task = task_handle::from_address(h.address());
+                    auto const exception = task.promise().exception_;
+                    tasks_.erase(std::find(tasks_.begin(), tasks_.end(), task));
+                    task.destroy();
+                    if (exception)
+                    {
+                        std::rethrow_exception(exception);
+                    }
+                }
+            }
+            return resumed;
+        }
+    };
+
+    /**
+     * \brief Coroutine front end of a ring_buffer_sequence
+     *
+     * Consumers co_await readable(n) or until(delimiter) instead of polling size(). The producer goes through
+     * fill_data here, which checks the suspended consumers once per fill and posts the satisfied ones to the executor.
+     * Everything runs on the executor's thread.
+     */
+    template <class Sequence>
+    class async_ring
+    {
+    public:
+        using const_iterator = typename Sequence::const_iterator;
+        using value_type = typename std::remove_const<typename const_iterator::value_type>::type;
+
+    private:
+        /*
+         * Suspended consumer; unregisters itself when its coroutine frame is destroyed before being woken up
+         */
+        class waiter
+        {
+            friend class async_ring;
+
+            std::coroutine_handle<> handle_;
+            bool registered_ = false;
+
+        protected:
+            async_ring & ring_;
+
+            explicit waiter(async_ring & ring) noexcept : ring_(ring) {}
+
+            ~waiter()
+            {
+                if (registered_)
+                {
+                    auto & waiters = ring_.waiters_;
+                    waiters.erase(std::find(waiters.begin(), waiters.end(), this));
+                }
+            }
+
+        public:
+            waiter(waiter const &) = delete;
+            waiter &operator =(waiter const &) = delete;
+
+            virtual bool ready() = 0;
+
+            void await_suspend(std::coroutine_handle<> h)
+            {
+                handle_ = h;
+                registered_ = true;
+                ring_.waiters_.push_back(this);
+            }
+        };
+
+        Sequence & sequence_;
+        ring_executor & executor_;
+        std::vector<waiter *> waiters_;
+
+        class readable_awaiter : public waiter
+        {
+            using waiter::ring_;
+            size_t n_;
+
+        public:
+            readable_awaiter(async_ring & ring, size_t n) : waiter(ring), n_(n) {}
+
+            bool ready() override
+            {
+                return ring_.sequence_.size() >= n_;
+            }
+            bool await_ready()
+            {
+                return ready();
+            }
+            size_t await_resume() const
+            {
+                return ring_.sequence_.size();
+            }
+        };
+
+        class until_awaiter : public waiter
+        {
+            using waiter::ring_;
+            ring_searcher<Sequence> searcher_;
+            const_iterator match_;
+
+        public:
+            template <class It>
+            until_awaiter(async_ring & ring, It first, It last) : waiter(ring), searcher_(ring.sequence_, first, last), match_(ring.sequence_.end()) {}
+
+            bool ready() override
+            {
+                match_ = searcher_.next();
+                return match_ != ring_.sequence_.end();
+            }
+            bool await_ready()
+            {
+                return ready();
+            }
+            const_iterator await_resume() const
+            {
+                return match_;
+            }
+        };
+
+    public:
+        async_ring(Sequence & seq, ring_executor & executor) : sequence_(seq), executor_(executor) {}
+
+        async_ring(async_ring const &) = delete;
+        async_ring &operator =(async_ring const &) = delete;
+
+        /*
+         * Consumers still suspended here are never woken up; their frames go with the executor
+         */
+        ~async_ring()
+        {
+            for (auto w : waiters_)
+            {
+                w->registered_ = false;
+            }
+        }
+
+        /**
+         * Appends data and wakes up every consumer whose condition now holds
+         */
+        size_t fill_data(value_type const * const external_buf, uint8_t bytes_transferred)
+        {
+            auto const n = sequence_.fill_data(external_buf, bytes_transferred);
+            auto const satisfied = std::stable_partition(waiters_.begin(), waiters_.end(), [](waiter * w) { return !w->ready(); });
+            for (auto it = satisfied; it != waiters_.end(); ++it)
+            {
+                (*it)->registered_ = false;
+                executor_.post((*it)->handle_);
+            }
+            waiters_.erase(satisfied, waiters_.end());
+            return n;
+        }
+
+        /**
+         * Suspends until at least n elements are available
+         * @return (by co_await) the number of elements available
+         */
+        readable_awaiter readable(size_t n)
+        {
+            return readable_awaiter {*this, n};
+        }
+
+        /**
+         * Suspends until the delimiter shows up; string literals convert without their terminating null
+         * @return (by co_await) iterator to the start of the delimiter
+         */
+        until_awaiter until(std::basic_string_view<value_type> delimiter)
+        {
+            return until_awaiter {*this, delimiter.begin(), delimiter.end()};
+        }
+
+        template <class It>
+        until_awaiter until(It first, It last)
+        {
+            return until_awaiter {*this, first, last};
+        }
+
+        [[nodiscard]] Sequence & sequence() const noexcept
+        {
+            return sequence_;
+        }
+    };
+}
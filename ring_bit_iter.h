@@ -0,0 +1,175 @@
+#pragma once
+#include "ring_iter.h"
+#include <bit>
+#include <cstddef>   // std::byte
+#include <cstring>
+
+namespace funny_it
+{
+    /**
+     * \brief Bit iterator over the live region of a byte ring, least significant bit of each byte first (as bit_iterator)
+     */
+    template <class Sequence>
+    class ring_bit_iterator : public std::iterator<std::forward_iterator_tag, std::byte const, ptrdiff_t, void, std::byte>
+    {
+        template <class>
+        friend class ring_bit_view;
+
+        using byte_type = typename std::remove_const<typename Sequence::const_iterator::value_type>::type;
+
+        Sequence const * sequence_ = nullptr;
+        byte_type const * current_byte = nullptr;
+        int8_t current_bit = 0;
+
+        ring_bit_iterator(Sequence const * seq, byte_type const * ptr) : sequence_(seq), current_byte(ptr) {}
+
+    public:
+        using class_type = ring_bit_iterator<Sequence>;
+
+        ring_bit_iterator() = default;
+
+        bool operator == (class_type const & other) const noexcept
+        {
+            return (current_byte == other.current_byte) && (current_bit == other.current_bit);
+        }
+
+        bool operator != (class_type const & other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+        std::byte operator * () const noexcept
+        {
+            return ((std::byte(*current_byte) & (std::byte(1) << current_bit)) > std::byte(0)) ? std::byte{1} : std::byte{0};
+        }
+
+        class_type & operator ++ () noexcept
+        {
+            if (++current_bit == 8)
+            {
+                current_bit = 0;
+                if (++current_byte == sequence_->bend())
+                {
+                    current_byte = sequence_->bbegin();
+                }
+            }
+            return *this;
+        }
+
+        class_type operator ++ (int) noexcept
+        {
+            class_type ret(*this);
+            operator++();
+            return ret;
+        }
+
+        /*
+         * Position in bits from the tail of the sequence
+         */
+        [[nodiscard]] size_t offset() const noexcept
+        {
+            return ((current_byte - sequence_->tail() + sequence_->bsize()) % sequence_->bsize()) * 8 + current_bit;
+        }
+    };
+
+    /**
+     * \brief Bit-level view of the live region [tail, head) of a byte ring_buffer_sequence, no linearization needed
+     *
+     * Positions are bit offsets from the tail. Whole bytes consumed so far map back to a const_iterator
+     * of the sequence through release_point(), to be passed to align().
+     */
+    template <class Sequence>
+    class ring_bit_view
+    {
+        Sequence const & sequence_;
+
+        using byte_type = typename ring_bit_iterator<Sequence>::byte_type;
+        static_assert(sizeof(byte_type) == 1);
+
+        byte_type const * byte_at(size_t byte_offset) const noexcept
+        {
+            return sequence_.bbegin() + (sequence_.tail() - sequence_.bbegin() + byte_offset) % sequence_.bsize();
+        }
+
+        /*
+         * Little-endian load of n <= 8 bytes: one memcpy when they do not cross the end of the storage
+         */
+        uint64_t load(size_t byte_offset, size_t n) const noexcept
+        {
+            auto const first = byte_at(byte_offset);
+            auto const rest_1 = std::min(n, static_cast<size_t>(sequence_.bend() - first));
+            uint64_t word = 0;
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                std::memcpy(&word, first, rest_1);
+                std::memcpy(reinterpret_cast<unsigned char *>(&word) + rest_1, sequence_.bbegin(), n - rest_1);
+            } else
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    word |= uint64_t(static_cast<unsigned char>(*byte_at(byte_offset + i))) << (8 * i);
+                }
+            }
+            return word;
+        }
+
+    public:
+        using const_iterator = ring_bit_iterator<Sequence>;
+
+        explicit ring_bit_view(Sequence const & seq) : sequence_(seq) {}
+
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            return const_iterator {&sequence_, sequence_.tail()};
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return const_iterator {&sequence_, sequence_.head()};
+        }
+
+        [[nodiscard]] size_t size() const noexcept
+        {
+            return sequence_.size() * 8;
+        }
+
+        /**
+         * Reads count (<= 64) bits starting at bit_offset, the first bit ending up in the least significant position.
+         * The bits must lie within the live region.
+         */
+        [[nodiscard]] uint64_t read_bits(size_t bit_offset, size_t count) const noexcept
+        {
+            if (count == 0)
+            {
+                return 0;
+            }
+            auto const byte_offset = bit_offset / 8;
+            auto const shift = bit_offset % 8;
+            auto const bytes = (shift + count + 7) / 8;
+            auto word = load(byte_offset, std::min(bytes, size_t(8))) >> shift;
+            if (bytes > 8)
+            {
+                word |= uint64_t(static_cast<unsigned char>(*byte_at(byte_offset + 8))) << (64 - shift);
+            }
+            return (count == 64) ? word : word & ((uint64_t(1) << count) - 1);
+        }
+
+        [[nodiscard]] uint64_t read_bits(const_iterator it, size_t count) const noexcept
+        {
+            return read_bits(it.offset(), count);
+        }
+
+        /**
+         * @return sequence iterator past the whole bytes before bit_offset, for align()
+         */
+        [[nodiscard]] typename Sequence::const_iterator release_point(size_t bit_offset) const
+        {
+            return sequence_.begin() + static_cast<int>(bit_offset / 8);
+        }
+
+        [[nodiscard]] typename Sequence::const_iterator release_point(const_iterator it) const
+        {
+            return release_point(it.offset());
+        }
+    };
+}
@@ -0,0 +1,175 @@
+#pragma once
+#include "ring_iter.h"
+#include <atomic>
+
+namespace funny_it
+{
+    /**
+     * \brief All reader slots of a broadcast_ring are taken
+     */
+    struct no_reader_slot : public std::exception {};
+
+    /**
+     * \brief Single producer ring broadcasting to up to Readers independent consumers
+     *
+     * Every reader has its own cursor and its own ring_buffer_sequence view of the shared storage,
+     * so it iterates with the usual const_iterator and gets its own iterator generation.
+     * The producer is gated only by the slowest registered reader. Cursors are lock-free
+     * and live on separate cache lines.
+     */
+    template <class V, size_t N, size_t Readers, class E = exception_checked_variant_type>
+    class broadcast_ring
+    {
+        static_assert(std::atomic<size_t>::is_always_lock_free);
+
+        struct alignas(cache_line_size) cursor
+        {
+            std::atomic<size_t> tail {0};
+            std::atomic<bool> registered {false};
+        };
+
+        V (& buf_)[N];
+        alignas(cache_line_size) std::atomic<size_t> head_ {0};
+        cursor cursors_[Readers];
+
+        size_t vacant() const noexcept
+        {
+            auto const head = head_.load(std::memory_order_relaxed);
+            size_t vacant = N - 1;
+            for (auto const & c : cursors_)
+            {
+                if (c.registered.load(std::memory_order_acquire))
+                {
+                    vacant = std::min(vacant, (c.tail.load(std::memory_order_acquire) + N - head - 1) % N);
+                }
+            }
+            return vacant;
+        }
+
+    public:
+        using sequence_type = ring_buffer_sequence<V, N, E>;
+        using const_iterator = typename sequence_type::const_iterator;
+
+        /**
+         * \brief Consumer side: a cursor of its own over the shared storage
+         */
+        class reader
+        {
+            friend class broadcast_ring;
+
+            broadcast_ring & ring_;
+            cursor & cursor_;
+            sequence_type view_;
+
+            reader(broadcast_ring & ring, cursor & c) : ring_(ring), cursor_(c), view_(ring.buf_)
+            {
+                auto const tail = view_.bbegin() + cursor_.tail.load(std::memory_order_relaxed);
+                view_.head_ = view_.tail_ = tail;
+            }
+
+            void publish() noexcept
+            {
+                cursor_.tail.store(view_.tail_ - view_.bbegin(), std::memory_order_release);
+            }
+
+        public:
+            reader(reader const &) = delete;
+            reader &operator =(reader const &) = delete;
+
+            ~reader()
+            {
+                cursor_.registered.store(false, std::memory_order_release);
+            }
+
+            /**
+             * Makes the data published by the producer so far visible to this reader
+             * @return number of elements available
+             */
+            size_t refresh() noexcept
+            {
+                view_.head_ = view_.bbegin() + ring_.head_.load(std::memory_order_acquire);
+                return view_.size();
+            }
+
+            [[nodiscard]] const_iterator begin() const noexcept
+            {
+                return view_.begin();
+            }
+
+            [[nodiscard]] const_iterator end() const noexcept
+            {
+                return view_.end();
+            }
+
+            [[nodiscard]] size_t size() const noexcept
+            {
+                return view_.size();
+            }
+
+            [[nodiscard]] sequence_type const & sequence() const noexcept
+            {
+                return view_;
+            }
+
+            void align() noexcept
+            {
+                view_.align();
+                publish();
+            }
+
+            void align(const_iterator it)
+            {
+                view_.align(it);
+                publish();
+            }
+
+            size_t drain(V * const out, size_t max)
+            {
+                auto const n = view_.drain(out, max);
+                publish();
+                return n;
+            }
+        };
+
+        explicit broadcast_ring(V (& buffer)[N]) : buf_(buffer) {}
+        explicit broadcast_ring(std::array<V, N> & array) : buf_(reinterpret_cast<V (&)[N]>(array))
+        {
+            static_assert (sizeof array == sizeof(V[N]));
+        }
+
+        broadcast_ring(broadcast_ring const &) = delete;
+        broadcast_ring &operator =(broadcast_ring const &) = delete;
+
+        /**
+         * Registers a reader starting at the current head; it sees only data filled in afterwards
+         */
+        reader subscribe()
+        {
+            for (auto & c : cursors_)
+            {
+                bool expected = false;
+                if (c.registered.compare_exchange_strong(expected, true))
+                {
+                    c.tail.store(head_.load());
+                    return reader(*this, c);
+                }
+            }
+            throw no_reader_slot();
+        }
+
+        /**
+         * Appends as much data as the slowest reader leaves room for and publishes it to all readers
+         * @return number of elements taken from external_buf
+         */
+        size_t fill_data(V const * const external_buf, size_t bytes_transferred)
+        {
+            auto const accepted = std::min(bytes_transferred, vacant());
+            auto const head = head_.load(std::memory_order_relaxed);
+            auto const rest_1 = std::min(accepted, N - head);
+            std::copy (external_buf, external_buf + rest_1, std::begin(buf_) + head);
+            std::copy (external_buf + rest_1, external_buf + accepted, std::begin(buf_));
+            head_.store((head + accepted) % N, std::memory_order_release);
+            return accepted;
+        }
+    };
+}
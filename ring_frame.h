@@ -0,0 +1,231 @@
+#pragma once
+#include "ring_iter.h"
+#include "ring_search.h"
+#include <optional>
+#include <exception>
+
+namespace funny_it
+{
+    /**
+     * \brief Frame header could not be decoded
+     */
+    struct malformed_header : public std::exception {};
+
+    /**
+     * \brief Frame can never fit into the ring
+     */
+    struct oversized_frame : public std::exception {};
+
+    /*
+     * Placement of a frame relative to where parsing started
+     */
+    struct frame_extent
+    {
+        size_t payload_offset;
+        size_t payload_size;
+        size_t frame_size;
+    };
+
+    /*
+     * Checks a header-supplied length before anything is added to it
+     */
+    template <class Sequence>
+    frame_extent make_frame_extent(Sequence const & seq, size_t header_size, size_t payload_size)
+    {
+        auto const capacity = seq.bsize() - 1;
+        if ((header_size > capacity) || (payload_size > capacity - header_size))
+        {
+            throw oversized_frame();
+        }
+        return frame_extent {header_size, payload_size, header_size + payload_size};
+    }
+
+    template <class Sequence>
+    auto frame_byte(Sequence const & seq, size_t offset) noexcept
+    {
+        return static_cast<unsigned char>(*(seq.bbegin() + (seq.tail() - seq.bbegin() + offset) % seq.bsize()));
+    }
+
+    /**
+     * \brief Frames prefixed with a fixed size big-endian (network order) length
+     */
+    template <size_t Bytes>
+    struct length_prefix_framing
+    {
+        static_assert(Bytes > 0 && Bytes <= sizeof(size_t));
+
+        template <class Sequence>
+        std::optional<frame_extent> frame(Sequence const & seq, size_t offset)
+        {
+            auto const available = seq.size() - offset;
+            if (available < Bytes)
+            {
+                return std::nullopt;
+            }
+            size_t payload = 0;
+            for (size_t i = 0; i < Bytes; ++i)
+            {
+                payload = (payload << 8) | frame_byte(seq, offset + i);
+            }
+            return make_frame_extent(seq, Bytes, payload);
+        }
+    };
+
+    /**
+     * \brief Frames prefixed with a LEB128 varint length
+     */
+    struct varint_framing
+    {
+        static constexpr size_t max_header = (sizeof(size_t) * 8 + 6) / 7;
+
+        template <class Sequence>
+        std::optional<frame_extent> frame(Sequence const & seq, size_t offset)
+        {
+            auto const available = seq.size() - offset;
+            size_t payload = 0;
+            for (size_t i = 0; i < max_header; ++i)
+            {
+                if (i == available)
+                {
+                    return std::nullopt;
+                }
+                auto const byte = frame_byte(seq, offset + i);
+                if ((i == max_header - 1) && ((byte & 0x7F) >> (sizeof(size_t) * 8 - 7 * i)))
+                {
+                    throw malformed_header();   // length does not fit size_t
+                }
+                payload |= size_t(byte & 0x7F) << (7 * i);
+                if (!(byte & 0x80))
+                {
+                    return make_frame_extent(seq, i + 1, payload);
+                }
+            }
+            throw malformed_header();
+        }
+    };
+
+    /**
+     * \brief Frames terminated by a delimiter, searched for incrementally with ring_searcher
+     */
+    template <class Sequence>
+    class delimiter_framing
+    {
+        ring_searcher<Sequence> searcher_;
+        size_t delimiter_size_;
+
+    public:
+        template <class It>
+        delimiter_framing(Sequence const & seq, It first, It last) : searcher_(seq, first, last), delimiter_size_(std::distance(first, last)) {}
+
+        std::optional<frame_extent> frame(Sequence const & seq, size_t offset)
+        {
+            auto const it = searcher_.next();
+            if (it == seq.end())
+            {
+                if (seq.size() - offset == seq.bsize() - 1)
+                {
+                    throw oversized_frame();    // the ring is full of this frame and still holds no delimiter
+                }
+                return std::nullopt;
+            }
+            auto const payload = static_cast<size_t>(seq.distance(seq.begin(), it)) - offset;
+            return frame_extent {0, payload, payload + delimiter_size_};
+        }
+    };
+
+    template <class Sequence, class It>
+    delimiter_framing(Sequence const &, It, It) -> delimiter_framing<Sequence>;
+
+    /**
+     * \brief Payload of a frame as one or two spans over ring storage, valid until released
+     */
+    template <class V>
+    class ring_message
+    {
+        template <class Sequence, class Framing>
+        friend class ring_framer;
+
+        size_t stream_end_;
+
+        ring_message(V const * first, size_t first_size, V const * second, size_t second_size, size_t stream_end) :
+            stream_end_(stream_end), first(first), first_size(first_size), second(second), second_size(second_size) {}
+
+    public:
+        V const * first;
+        size_t first_size;
+        V const * second;    // continuation after the wrap point, nullptr if the payload is contiguous
+        size_t second_size;
+
+        [[nodiscard]] size_t size() const noexcept
+        {
+            return first_size + second_size;
+        }
+
+        [[nodiscard]] bool contiguous() const noexcept
+        {
+            return second_size == 0;
+        }
+    };
+
+    /**
+     * \brief Splits the contents of a ring_buffer_sequence into messages without copying them
+     *
+     * The framer owns the tail of the sequence: messages are handed out in order by next(),
+     * and release() aligns the tail past a message (and all messages before it).
+     */
+    template <class Sequence, class Framing>
+    class ring_framer
+    {
+    public:
+        using value_type = typename std::remove_const<typename Sequence::const_iterator::value_type>::type;
+        using message_type = ring_message<value_type>;
+
+    private:
+        Sequence & sequence_;
+        Framing framing_;
+        size_t produced_ = 0;   // stream position past the last handed out frame
+        size_t released_ = 0;   // stream position of the tail
+
+    public:
+        ring_framer(Sequence & seq, Framing framing) : sequence_(seq), framing_(std::move(framing)) {}
+
+        /**
+         * @return the next complete message, or nothing until more data is filled in
+         */
+        std::optional<message_type> next()
+        {
+            auto const offset = produced_ - released_;
+            auto const extent = framing_.frame(sequence_, offset);
+            if (!extent)
+            {
+                return std::nullopt;
+            }
+            if (extent->frame_size >= sequence_.bsize())
+            {
+                throw oversized_frame();
+            }
+            if (offset + extent->frame_size > sequence_.size())
+            {
+                return std::nullopt;
+            }
+
+            auto const start = (sequence_.tail() - sequence_.bbegin() + offset + extent->payload_offset) % sequence_.bsize();
+            auto const first_size = std::min(extent->payload_size, sequence_.bsize() - start);
+            auto const second_size = extent->payload_size - first_size;
+            produced_ += extent->frame_size;
+            return message_type {sequence_.bbegin() + start, first_size, second_size ? sequence_.bbegin() : nullptr, second_size, produced_};
+        }
+
+        /**
+         * Gives the storage of the message and of all messages handed out before it back to the ring
+         */
+        void release(message_type const & message)
+        {
+            if (message.stream_end_ > released_)
+            {
+                sequence_.align(sequence_.begin() + static_cast<int>(message.stream_end_ - released_));
+                released_ = message.stream_end_;
+            }
+        }
+    };
+}
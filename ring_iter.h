@@ -3,11 +3,149 @@
 #include <array>
 #include <algorithm>
 #include <exception>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#if __has_include(<ranges>)
+#include <ranges>
+#endif
 
 namespace funny_it
 {
     using exception_checked_variant_type = std::integral_constant<bool, true>;
     using exception_unchecked_variant_type = std::integral_constant<bool, false>;
+
+    /*
+     * What fill_data does when the incoming data does not fit into the ring:
+     * throw overflow_exception (default), drop the oldest data, write as much as fits and
+     * report the count, or wait until the consumer frees space with align().
+     */
+    struct full_throw_variant_type {};
+    struct full_overwrite_variant_type {};
+    struct full_reject_variant_type {};
+
+    class full_block_variant_type
+    {
+        template<class, size_t, class, class, class>
+        friend class ring_buffer_sequence;
+
+        std::mutex mutex_;
+        std::condition_variable space_freed_;
+    };
+
+    constexpr size_t cache_line_size = 64;
+
+    /*
+     * Head or tail shared between a producer and a consumer thread (full_block_variant_type):
+     * stores publish with release, loads acquire
+     */
+    template <class V>
+    class synchronized_position
+    {
+        std::atomic<V *> ptr_;
+
+    public:
+        synchronized_position(V * ptr) noexcept : ptr_(ptr) {}
+
+        operator V * () const noexcept
+        {
+            return ptr_.load(std::memory_order_acquire);
+        }
+
+        synchronized_position & operator =(V * ptr) noexcept
+        {
+            ptr_.store(ptr, std::memory_order_release);
+            return *this;
+        }
+    };
+
+    /**
+     * \brief Snapshot of ring_buffer_sequence counters
+     */
+    struct ring_stats
+    {
+        uint64_t fills = 0;
+        uint64_t aligns = 0;
+        uint64_t bytes_in = 0;
+        uint64_t bytes_out = 0;
+        uint64_t high_water = 0;
+        uint64_t overflows = 0;     // fill_data calls that found the ring full, whatever the F policy did about it
+        uint64_t generations = 0;   // reset() calls and overwriting drops (the iterator generations of the checked variant)
+    };
+
+    /*
+     * Statistics policies: disabled hooks compile to nothing,
+     * enabled ones keep relaxed atomic counters (safe from any thread), producer and consumer side on separate cache lines.
+     */
+    struct ring_stats_disabled_variant_type
+    {
+        constexpr void on_fill(size_t, size_t) noexcept {}
+        constexpr void on_overflow() noexcept {}
+        constexpr void on_align(size_t) noexcept {}
+        constexpr void on_generation() noexcept {}
+        [[nodiscard]] constexpr ring_stats snapshot() const noexcept
+        {
+            return {};
+        }
+    };
+
+    class ring_stats_enabled_variant_type
+    {
+        struct alignas(cache_line_size) producer_side
+        {
+            std::atomic<uint64_t> fills {0};
+            std::atomic<uint64_t> bytes_in {0};
+            std::atomic<uint64_t> high_water {0};
+            std::atomic<uint64_t> overflows {0};
+            std::atomic<uint64_t> generations {0};
+        } producer_;
+        struct alignas(cache_line_size) consumer_side
+        {
+            std::atomic<uint64_t> aligns {0};
+            std::atomic<uint64_t> bytes_out {0};
+        } consumer_;
+
+        static void bump(std::atomic<uint64_t> & counter, uint64_t n = 1) noexcept
+        {
+            counter.fetch_add(n, std::memory_order_relaxed);
+        }
+
+    public:
+        void on_fill(size_t n, size_t size) noexcept
+        {
+            bump(producer_.fills);
+            bump(producer_.bytes_in, n);
+            auto high_water = producer_.high_water.load(std::memory_order_relaxed);
+            while ((size > high_water) && !producer_.high_water.compare_exchange_weak(high_water, size, std::memory_order_relaxed)) {}
+        }
+        void on_overflow() noexcept
+        {
+            bump(producer_.overflows);
+        }
+        void on_align(size_t n) noexcept
+        {
+            bump(consumer_.aligns);
+            bump(consumer_.bytes_out, n);
+        }
+        void on_generation() noexcept
+        {
+            bump(producer_.generations);
+        }
+        [[nodiscard]] ring_stats snapshot() const noexcept
+        {
+            ring_stats ret;
+            ret.fills = producer_.fills.load(std::memory_order_relaxed);
+            ret.aligns = consumer_.aligns.load(std::memory_order_relaxed);
+            ret.bytes_in = producer_.bytes_in.load(std::memory_order_relaxed);
+            ret.bytes_out = consumer_.bytes_out.load(std::memory_order_relaxed);
+            ret.high_water = producer_.high_water.load(std::memory_order_relaxed);
+            ret.overflows = producer_.overflows.load(std::memory_order_relaxed);
+            ret.generations = producer_.generations.load(std::memory_order_relaxed);
+            return ret;
+        }
+    };
     /*
      * Iterator belongs to the sequence that spawned it recently through begin(), end() and the sequence was not reset().
      */
@@ -53,14 +191,16 @@ namespace funny_it
     template<typename Iter>
     static bool is_iter_valid(Iter const & it) noexcept
     {
-        if (it.sequence_->head_ >= it.sequence_->tail_)
+        typename Iter::value_type const * const head = it.sequence_->head_;
+        typename Iter::value_type const * const tail = it.sequence_->tail_;
+        if (head >= tail)
         {
-            if (it.ptr_ < it.sequence_->tail_)
+            if (it.ptr_ < tail)
                 return false;
-            return it.ptr_ <= it.sequence_->head_;
+            return it.ptr_ <= head;
         } else
         {
-            return !((it.ptr_ < it.sequence_->tail_) && (it.ptr_ > it.sequence_->head_));
+            return !((it.ptr_ < tail) && (it.ptr_ > head));
         }
     }
 
@@ -101,10 +241,112 @@ namespace funny_it
     template<typename Iter>
     void throw_if_iterator_abnormal(Iter const & it, exception_unchecked_variant_type) noexcept {}
 
-    template<class, size_t, class E>
+    template<class, size_t, class E, class F, class S>
     class ring_buffer_sequence;
 
-    template <class ValueType, size_t N, class E>
+    template <class Sequence>
+    class ring_scan_position;
+
+    template <class, size_t, size_t, class>
+    class broadcast_ring;
+
+    template <class, size_t, class>
+    class object_ring;
+
+    /**
+     * \brief End marker of a ring_view: compared with an iterator by pointer only
+     */
+    template <class ValueType>
+    class ring_sentinel
+    {
+        ValueType const * ptr_ = nullptr;
+
+    public:
+        constexpr ring_sentinel() noexcept = default;
+        constexpr explicit ring_sentinel(ValueType const * ptr) noexcept : ptr_(ptr) {}
+
+        constexpr ValueType const * get() const noexcept
+        {
+            return ptr_;
+        }
+    };
+
+    /**
+     * \brief Iterator of a ring_view: a bare pointer that wraps at the end of the buffer
+     *
+     * Unlike ring_buffer_iterator it carries no generation and checks nothing on dereference or increment,
+     * so it must not be used once the sequence has been reset() or aligned past it.
+     */
+    template <class ValueType>
+    class ring_view_iterator
+    {
+        ValueType * ptr_ = nullptr;
+        ValueType * bbegin_ = nullptr;
+        ValueType * bend_ = nullptr;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename std::remove_const<ValueType>::type;
+        using difference_type = ptrdiff_t;
+        using pointer = ValueType *;
+        using reference = ValueType &;
+
+        constexpr ring_view_iterator() noexcept = default;
+        constexpr ring_view_iterator(ValueType * ptr, ValueType * bbegin, ValueType * bend) noexcept : ptr_(ptr), bbegin_(bbegin), bend_(bend) {}
+
+        constexpr reference operator *() const noexcept
+        {
+            return *ptr_;
+        }
+
+        constexpr ring_view_iterator & operator ++() noexcept
+        {
+            if (++ptr_ == bend_)
+            {
+                ptr_ = bbegin_;
+            }
+            return *this;
+        }
+
+        constexpr ring_view_iterator operator ++(int) noexcept
+        {
+            auto const result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend constexpr bool operator ==(ring_view_iterator const & lhs, ring_view_iterator const & rhs) noexcept
+        {
+            return lhs.ptr_ == rhs.ptr_;
+        }
+
+        friend constexpr bool operator !=(ring_view_iterator const & lhs, ring_view_iterator const & rhs) noexcept
+        {
+            return lhs.ptr_ != rhs.ptr_;
+        }
+
+        friend constexpr bool operator ==(ring_view_iterator const & it, ring_sentinel<value_type> s) noexcept
+        {
+            return it.ptr_ == s.get();
+        }
+
+        friend constexpr bool operator ==(ring_sentinel<value_type> s, ring_view_iterator const & it) noexcept
+        {
+            return it.ptr_ == s.get();
+        }
+
+        friend constexpr bool operator !=(ring_view_iterator const & it, ring_sentinel<value_type> s) noexcept
+        {
+            return it.ptr_ != s.get();
+        }
+
+        friend constexpr bool operator !=(ring_sentinel<value_type> s, ring_view_iterator const & it) noexcept
+        {
+            return it.ptr_ != s.get();
+        }
+    };
+
+    template <class ValueType, size_t N, class E, class F = full_throw_variant_type, class S = ring_stats_disabled_variant_type>
     class ring_buffer_iterator: public std::iterator<std::forward_iterator_tag, ValueType, ptrdiff_t, void, ValueType>
     {
         template<typename Iter>
@@ -114,13 +356,15 @@ namespace funny_it
 
         template <class It>
         friend class outdated_iterator;
+        template <class Sequence>
+        friend class ring_scan_position;
 
 
     public:
-        friend class ring_buffer_sequence<ValueType, N, E>;
-        using sequence_class = ring_buffer_sequence<ValueType, N, E>;
+        friend class ring_buffer_sequence<ValueType, N, E, F, S>;
+        using sequence_class = ring_buffer_sequence<ValueType, N, E, F, S>;
 
-        using class_type = ring_buffer_iterator<ValueType, N, E>;
+        using class_type = ring_buffer_iterator<ValueType, N, E, F, S>;
         using value_type = ValueType;
 
     private:
@@ -172,6 +416,26 @@ namespace funny_it
             return !(*this == other);
         }
 
+        friend constexpr bool operator ==(class_type const & it, ring_sentinel<value_type> s) noexcept
+        {
+            return it.ptr_ == s.get();
+        }
+
+        friend constexpr bool operator ==(ring_sentinel<value_type> s, class_type const & it) noexcept
+        {
+            return it.ptr_ == s.get();
+        }
+
+        friend constexpr bool operator !=(class_type const & it, ring_sentinel<value_type> s) noexcept
+        {
+            return it.ptr_ != s.get();
+        }
+
+        friend constexpr bool operator !=(ring_sentinel<value_type> s, class_type const & it) noexcept
+        {
+            return it.ptr_ != s.get();
+        }
+
         constexpr value_type & operator *() const
         {
             throw_if_iterator_abnormal (*this, E());
@@ -180,7 +444,15 @@ namespace funny_it
 
         constexpr class_type & operator ++()
         {
-            return *this += 1;
+            throw_if_iter_outdated(*this, E());
+            auto tmp_ptr = ptr_ + 1;
+            if (tmp_ptr == sequence_->bend())
+            {
+                tmp_ptr = sequence_->bbegin();
+            }
+            throw_if_iter_invalid(class_type (sequence_, tmp_ptr), E());
+            ptr_ = tmp_ptr;
+            return *this;
         }
 
         constexpr class_type operator +(int n) const
@@ -218,20 +490,20 @@ namespace funny_it
         }
     };
 
-    template <class V, size_t N, class E>
-    constexpr bool operator == (V const * const value, ring_buffer_iterator<V,N,E> const & iter) noexcept
+    template <class V, size_t N, class E, class F, class S>
+    constexpr bool operator == (V const * const value, ring_buffer_iterator<V,N,E,F,S> const & iter) noexcept
     {
         return iter == value;
     }
 
-    template <class V, size_t N, class E>
-    constexpr bool operator == (ring_buffer_iterator<V,N,E> const & iter, V const * const value) noexcept
+    template <class V, size_t N, class E, class F, class S>
+    constexpr bool operator == (ring_buffer_iterator<V,N,E,F,S> const & iter, V const * const value) noexcept
     {
         return iter == value;
     }
 
-    template <class V, size_t N, class E>
-    constexpr ring_buffer_iterator<V,N,E> operator + (ring_buffer_iterator<V,N,E> const & iter, int n)
+    template <class V, size_t N, class E, class F, class S>
+    constexpr ring_buffer_iterator<V,N,E,F,S> operator + (ring_buffer_iterator<V,N,E,F,S> const & iter, int n)
     {
         auto tmp(iter);
         return tmp+n;
@@ -262,17 +534,63 @@ namespace funny_it
 
     struct iter_mixture : public std::exception {};
 
-    template <class V, size_t N, class E = exception_checked_variant_type>
+#if defined(__cpp_lib_ranges)
+    template <class D>
+    using ring_view_base = std::ranges::view_interface<D>;
+#else
+    template <class D>
+    struct ring_view_base {};
+#endif
+
+    /**
+     * \brief Live region of a sequence as an iterator/sentinel range (a borrowed std::ranges view when available)
+     *
+     * Iterates with ring_view_iterator: no per-element checks, valid until the sequence is reset() or aligned.
+     */
+    template <class Sequence>
+    class ring_view : public ring_view_base<ring_view<Sequence>>
+    {
+        Sequence const * sequence_ = nullptr;
+
+    public:
+        using const_iterator = typename Sequence::const_iterator;
+        using iterator = ring_view_iterator<typename const_iterator::value_type>;
+        using sentinel = ring_sentinel<typename const_iterator::value_type>;
+
+        constexpr ring_view() noexcept = default;
+        constexpr explicit ring_view(Sequence const & seq) noexcept : sequence_(&seq) {}
+
+        constexpr iterator begin() const noexcept
+        {
+            return iterator {sequence_->tail(), sequence_->bbegin(), sequence_->bend()};
+        }
+
+        constexpr sentinel end() const noexcept
+        {
+            return sentinel {sequence_->head()};
+        }
+    };
+
+    template <class V, size_t N, class E = exception_checked_variant_type, class F = full_throw_variant_type, class S = ring_stats_disabled_variant_type>
     class ring_buffer_sequence : private ring_buffer_base<V,N>
     {
         template<typename Iter>
         friend bool is_iter_up_to_date(Iter it) noexcept;
         template<typename Iter>
         friend bool is_iter_valid(Iter const & it) noexcept;
+        template <class, size_t, size_t, class>
+        friend class broadcast_ring;
+        template <class, size_t, class>
+        friend class object_ring;
 
-        V * head_ = bbegin();
-        V * tail_ = bbegin();
+        using position_type = typename std::conditional<std::is_same<F, full_block_variant_type>::value, synchronized_position<V>, V *>::type;
+
+        position_type head_ = bbegin();
+        position_type tail_ = bbegin();
         unsigned up_to_date_flag = 0;
+        size_t consumed_ = 0;
+        F full_policy_;
+        [[no_unique_address]] S stats_;
 
         void update_up_to_date_flag(exception_checked_variant_type) noexcept
         {
@@ -280,8 +598,130 @@ namespace funny_it
         }
         void update_up_to_date_flag(exception_unchecked_variant_type) noexcept {}
 
+        /*
+         * Tail movements are serialized with a blocked producer, which is woken up afterwards
+         */
+        template <class Fn>
+        static void move_tail(full_block_variant_type & policy, Fn && fn)
+        {
+            {
+                std::lock_guard<std::mutex> lock(policy.mutex_);
+                fn();
+            }
+            policy.space_freed_.notify_all();
+        }
+
+        template <class P, class Fn>
+        static constexpr void move_tail(P &, Fn && fn)
+        {
+            fn();
+        }
+
+        /*
+         * Only the blocking policy takes a mutex (which may throw) to move the tail
+         */
+        static constexpr bool nothrow_move_tail = !std::is_same<F, full_block_variant_type>::value;
+
+        /*
+         * Room left for fill_data: one element is always kept free to tell a full ring from an empty one
+         */
+        constexpr size_t vacant() const noexcept
+        {
+            return bsize() - 1 - size();
+        }
+
+        constexpr V * advanced(V * ptr, size_t n) const noexcept
+        {
+            return bbegin() + ((ptr - bbegin() + n) % bsize());
+        }
+
+        /*
+         * The new head is published only after the data is in place
+         */
+        constexpr void write(V const * const external_buf, size_t bytes_transferred)
+        {
+            V * head = head_;
+            if ((head + bytes_transferred) > bend())
+            {
+                auto const rest_1 = bend() - head;
+                std::copy (external_buf, external_buf + rest_1, head);
+                auto const rest_2 = head + bytes_transferred - bend();
+                std::copy (external_buf + rest_1, external_buf + rest_1 + rest_2, bbegin());
+                head = bbegin() + rest_2;
+            } else
+            {
+                std::copy (external_buf, external_buf + bytes_transferred, head);
+                if ((head += bytes_transferred) == bend())
+                {
+                    head = bbegin();
+                }
+            }
+            head_ = head;
+        }
+
+        constexpr size_t fill_data(V const * const external_buf, size_t bytes_transferred, full_throw_variant_type &)
+        {
+            if (size() + bytes_transferred >= bsize())
+            {
+                stats_.on_overflow();
+                throw overflow_exception();
+            }
+            write(external_buf, bytes_transferred);
+            return bytes_transferred;
+        }
+
+        constexpr size_t fill_data(V const * const external_buf, size_t bytes_transferred, full_reject_variant_type &)
+        {
+            auto const accepted = std::min(bytes_transferred, vacant());
+            if (accepted != bytes_transferred)
+            {
+                stats_.on_overflow();
+            }
+            write(external_buf, accepted);
+            return accepted;
+        }
+
+        constexpr size_t fill_data(V const * const external_buf, size_t bytes_transferred, full_overwrite_variant_type &)
+        {
+            auto const capacity = bsize() - 1;
+            auto const skipped = (bytes_transferred > capacity) ? bytes_transferred - capacity : 0;
+            auto const accepted = bytes_transferred - skipped;
+            if ((skipped != 0) || (accepted > vacant()))
+            {
+                stats_.on_overflow();
+            }
+            if (accepted > vacant())
+            {
+                auto const dropped = accepted - vacant();
+                tail_ = advanced(tail_, dropped);
+                consumed_ += dropped;
+                update_up_to_date_flag(E());
+                stats_.on_generation();
+            }
+            write(external_buf + skipped, accepted);
+            return bytes_transferred;
+        }
+
+        size_t fill_data(V const * const external_buf, size_t bytes_transferred, full_block_variant_type & policy)
+        {
+            std::unique_lock<std::mutex> lock(policy.mutex_);
+            size_t written = 0;
+            if (bytes_transferred > vacant())
+            {
+                stats_.on_overflow();
+            }
+            while (written != bytes_transferred)
+            {
+                policy.space_freed_.wait(lock, [this] { return vacant() != 0; });
+                auto const chunk = std::min(bytes_transferred - written, vacant());
+                write(external_buf + written, chunk);
+                written += chunk;
+            }
+            return written;
+        }
+
     public:
-        using class_type = ring_buffer_sequence<V,N>;
+        using class_type = ring_buffer_sequence<V,N,E,F,S>;
         using inherited_class_type = ring_buffer_base<V,N>;
         using inherited_class_type::bbegin;
         using inherited_class_type::bend;
@@ -289,7 +729,7 @@ namespace funny_it
 
         using typename inherited_class_type::buf_type ;
 
-        using const_iterator = ring_buffer_iterator<V, N, E>;
+        using const_iterator = ring_buffer_iterator<V, N, E, F, S>;
         friend const_iterator;
 
         explicit constexpr ring_buffer_sequence (V (& buffer)[N]) : ring_buffer_base<V,N>(buffer){}
@@ -304,22 +744,29 @@ namespace funny_it
         ring_buffer_sequence (class_type && other) noexcept = delete;
         ring_buffer_sequence &operator =(class_type && other) noexcept = delete;
 
-        void reset(const_iterator const & tail_iter, const_iterator const & head_iter) noexcept
+        void reset(const_iterator const & tail_iter, const_iterator const & head_iter) noexcept(nothrow_move_tail)
         {
-            if ((tail_iter.ptr_ != tail_) || (head_iter.ptr_ != head_))
+            move_tail(full_policy_, [this, &tail_iter, &head_iter]
             {
-                tail_ = tail_iter.ptr_;
-                head_ = head_iter.ptr_;
-                update_up_to_date_flag(E());
-            }
+                if ((tail_iter.ptr_ != tail_) || (head_iter.ptr_ != head_))
+                {
+                    tail_ = tail_iter.ptr_;
+                    head_ = head_iter.ptr_;
+                    update_up_to_date_flag(E());
+                    stats_.on_generation();
+                }
+            });
         }
-        void unchecked_reset(const_iterator const & tail_iter, const_iterator const & head_iter) noexcept
+        void unchecked_reset(const_iterator const & tail_iter, const_iterator const & head_iter) noexcept(nothrow_move_tail)
         {
-            if ((tail_iter.ptr_ != tail_) || (head_iter.ptr_ != head_))
+            move_tail(full_policy_, [this, &tail_iter, &head_iter]
             {
-                tail_ = tail_iter.ptr_;
-                head_ = head_iter.ptr_;
-            }
+                if ((tail_iter.ptr_ != tail_) || (head_iter.ptr_ != head_))
+                {
+                    tail_ = tail_iter.ptr_;
+                    head_ = head_iter.ptr_;
+                }
+            });
         }
 
         constexpr const_iterator begin() const noexcept
@@ -332,6 +779,14 @@ namespace funny_it
             return const_iterator {this, head_};
         }
 
+        /**
+         * Same elements as [begin(), end()), stepped by a bare wrapping pointer without the iterator checks
+         */
+        constexpr ring_view<class_type> view() const noexcept
+        {
+            return ring_view<class_type> {*this};
+        }
+
         constexpr V * head() const noexcept
         {
             return head_;
@@ -342,29 +797,82 @@ namespace funny_it
             return tail_;
         }
 
+        /**
+         * Number of elements released through the tail since construction, i.e. the stream position of tail().
+         * reset() does not take part in this count.
+         */
+        constexpr size_t consumed() const noexcept
+        {
+            return consumed_;
+        }
+
         struct overflow_exception
         {};
-        constexpr void fill_data(V const * const external_buf, uint8_t bytes_transferred)
+
+        /**
+         * Appends data at the head. A full ring is handled according to the F policy:
+         * full_throw_variant_type throws overflow_exception,
+         * full_overwrite_variant_type drops the oldest data (outstanding iterators get outdated),
+         * full_reject_variant_type writes only what fits,
+         * full_block_variant_type waits until align() frees enough space.
+         * @return number of elements taken from external_buf
+         */
+        constexpr size_t fill_data(V const * const external_buf, uint8_t bytes_transferred)
         {
-            if (size() + bytes_transferred >= bsize())
+            auto const n = fill_data(external_buf, bytes_transferred, full_policy_);
+            if constexpr (!std::is_same<S, ring_stats_disabled_variant_type>::value)
             {
-                throw overflow_exception();
+                stats_.on_fill(n, size());
             }
-            if ((head_ + bytes_transferred) > bend())
-            {
-                auto const rest_1 = bend() - head_;
-                std::copy (external_buf, external_buf + rest_1, head_);
-                auto const rest_2 = head_ + bytes_transferred - bend();
-                std::copy (external_buf + rest_1, external_buf + rest_1 + rest_2, bbegin());
-                head_ = bbegin() + rest_2;
-            } else
+            return n;
+        }
+
+        /**
+         * Counters collected by the S policy (all zero with ring_stats_disabled_variant_type)
+         */
+        [[nodiscard]] ring_stats stats() const noexcept
+        {
+            return stats_.snapshot();
+        }
+
+        /**
+         * Copies up to max elements from the tail without consuming them
+         * @return number of elements copied
+         */
+        constexpr size_t peek(V * const out, size_t max) const
+        {
+            auto const n = std::min(max, static_cast<size_t>(size()));
+            V const * const tail = tail_;
+            auto const rest_1 = std::min(n, static_cast<size_t>(bend() - tail));
+            std::copy (tail, tail + rest_1, out);
+            std::copy (bbegin(), bbegin() + (n - rest_1), out + rest_1);
+            return n;
+        }
+
+        /**
+         * Copies up to max elements from the tail and releases them, the counterpart of fill_data
+         * @return number of elements copied
+         */
+        constexpr size_t drain(V * const out, size_t max)
+        {
+            size_t n = 0;
+            move_tail(full_policy_, [this, out, max, &n]
             {
-                std::copy (external_buf, external_buf + bytes_transferred, head_);
-                if ((head_ += bytes_transferred) == bend())
-                {
-                    head_ = bbegin();
-                }
-            }
+                n = peek(out, max);
+                tail_ = advanced(tail_, n);
+                consumed_ += n;
+                stats_.on_align(n);
+            });
+            return n;
+        }
+
+        /**
+         * Drains into any contiguous destination exposing data() and size() (std::array, std::vector, span)
+         */
+        template <class Span>
+        constexpr size_t consume_into(Span && span)
+        {
+            return drain(std::data(span), std::size(span));
         }
 
         constexpr bool operator ==(class_type const & other) const noexcept
@@ -377,9 +885,16 @@ namespace funny_it
             return !(*this == other);
         }
 
-        constexpr void align() noexcept
+        constexpr void align() noexcept(nothrow_move_tail)
         {
-            tail_ = head_;
+            move_tail(full_policy_, [this]
+            {
+                V * const head = head_;
+                auto const n = static_cast<size_t>((head - tail() + bsize()) % bsize());
+                consumed_ += n;
+                stats_.on_align(n);
+                tail_ = head;
+            });
         }
 
         /**
@@ -388,17 +903,25 @@ namespace funny_it
          */
         constexpr void align (const_iterator it)
         {
-            tail_ = it.ptr_;
+            move_tail(full_policy_, [this, &it]
+            {
+                auto const n = static_cast<size_t>((it.ptr_ - tail_ + bsize()) % bsize());
+                consumed_ += n;
+                stats_.on_align(n);
+                tail_ = it.ptr_;
+            });
         }
 
         constexpr decltype(N) size() const noexcept
         {
-            if (head_ >= tail_)
+            V const * const head = head_;
+            V const * const tail = tail_;
+            if (head >= tail)
             {
-                return head_ - tail_;
+                return head - tail;
             } else
             {
-                return (bend() - tail_) + (head_ - bbegin());
+                return (bend() - tail) + (head - bbegin());
             }
         }
 
@@ -432,3 +955,7 @@ namespace funny_it
     };
 }
 
+#if defined(__cpp_lib_ranges)
+template <class Sequence>
+inline constexpr bool std::ranges::enable_borrowed_range<funny_it::ring_view<Sequence>> = true;
+#endif
@@ -0,0 +1,177 @@
+#pragma once
+#include "ring_iter.h"
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace funny_it
+{
+    /**
+     * \brief Ring of arbitrary (non default constructible, non trivial) objects over owned uninitialized storage
+     *
+     * Elements are constructed in place at the head and destroyed when they leave through pop_front, align or drain.
+     * Iteration goes through the usual ring_buffer_sequence const_iterator.
+     */
+    template <class V, size_t N, class E = exception_checked_variant_type>
+    class object_ring
+    {
+        alignas(V) unsigned char storage_[sizeof(V) * N];
+        ring_buffer_sequence<V, N, E> sequence_;
+
+        V * next(V * ptr) const noexcept
+        {
+            return (++ptr == sequence_.bend()) ? sequence_.bbegin() : ptr;
+        }
+
+        void throw_if_full(size_t n) const
+        {
+            if (sequence_.size() + n >= sequence_.bsize())
+            {
+                throw overflow_exception();
+            }
+        }
+
+        void destroy(V * first, V * last) noexcept
+        {
+            if constexpr (!std::is_trivially_destructible<V>::value)
+            {
+                for (; first != last; first = next(first))
+                {
+                    first->~V();
+                }
+            }
+        }
+
+    public:
+        using sequence_type = ring_buffer_sequence<V, N, E>;
+        using const_iterator = typename sequence_type::const_iterator;
+        using overflow_exception = typename sequence_type::overflow_exception;
+
+        object_ring() : sequence_(reinterpret_cast<V (&)[N]>(storage_)) {}
+
+        object_ring(object_ring const &) = delete;
+        object_ring &operator =(object_ring const &) = delete;
+
+        ~object_ring()
+        {
+            align();
+        }
+
+        template <class... Args>
+        V & emplace_back(Args && ... args)
+        {
+            throw_if_full(1);
+            auto const ptr = sequence_.head_;
+            ::new (static_cast<void *>(ptr)) V(std::forward<Args>(args)...);
+            sequence_.head_ = next(ptr);
+            return *ptr;
+        }
+
+        void push(V const & value)
+        {
+            emplace_back(value);
+        }
+
+        void push(V && value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        /**
+         * Copies n elements in; trivially copyable types take at most two memcpy calls
+         */
+        void fill_data(V const * const external_buf, size_t n)
+        {
+            throw_if_full(n);
+            if constexpr (std::is_trivially_copyable<V>::value)
+            {
+                auto const head = sequence_.head_;
+                auto const rest_1 = std::min(n, static_cast<size_t>(sequence_.bend() - head));
+                std::memcpy(static_cast<void *>(head), external_buf, rest_1 * sizeof(V));
+                std::memcpy(static_cast<void *>(sequence_.bbegin()), external_buf + rest_1, (n - rest_1) * sizeof(V));
+                sequence_.head_ = sequence_.bbegin() + (head - sequence_.bbegin() + n) % sequence_.bsize();
+            } else
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    emplace_back(external_buf[i]);
+                }
+            }
+        }
+
+        [[nodiscard]] V & front() const noexcept
+        {
+            return *sequence_.tail_;
+        }
+
+        /*
+         * The ring must not be empty
+         */
+        void pop_front() noexcept
+        {
+            auto const tail = sequence_.tail_;
+            sequence_.tail_ = next(tail);
+            ++sequence_.consumed_;
+            tail->~V();
+        }
+
+        /**
+         * Moves up to max elements out and destroys them in the ring
+         * @return number of elements moved out
+         */
+        size_t drain(V * out, size_t max)
+        {
+            size_t n = 0;
+            for (; (n != max) && (sequence_.tail_ != sequence_.head_); ++n)
+            {
+                *out++ = std::move(front());
+                pop_front();
+            }
+            return n;
+        }
+
+        /**
+         * Destroys the elements in front of the passed iterator
+         */
+        void align(const_iterator it)
+        {
+            throw_if_iterator_abnormal(it, E());
+            auto const tail = sequence_.tail_;
+            sequence_.align(it);
+            destroy(tail, sequence_.tail_);
+        }
+
+        void align() noexcept
+        {
+            auto const tail = sequence_.tail_;
+            sequence_.align();
+            destroy(tail, sequence_.tail_);
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            return sequence_.begin();
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return sequence_.end();
+        }
+
+        [[nodiscard]] size_t size() const noexcept
+        {
+            return sequence_.size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return sequence_.head_ == sequence_.tail_;
+        }
+
+        [[nodiscard]] sequence_type const & sequence() const noexcept
+        {
+            return sequence_;
+        }
+    };
+}
@@ -0,0 +1,372 @@
+#pragma once
+#include "ring_iter.h"
+#include <vector>
+#include <string_view>
+#include <initializer_list>
+#include <cstdint>
+
+namespace funny_it
+{
+    /**
+     * \brief Scan position of a resumable search over a ring_buffer_sequence
+     *
+     * The position is kept in stream coordinates (see Sequence::consumed()), so it survives the ring wrapping
+     * around. It is dropped (and the scan starts over from the tail) when the sequence was reset()
+     * (checked variant only) or when align() released bytes the search still depends on.
+     */
+    template <class Sequence>
+    class ring_scan_position
+    {
+    public:
+        using const_iterator = typename Sequence::const_iterator;
+        using value_type = typename const_iterator::value_type;
+
+    protected:
+        Sequence const & sequence_;
+        const_iterator generation_;
+        size_t scanned_;
+
+        explicit ring_scan_position(Sequence const & seq) : sequence_(seq), generation_(seq.begin()), scanned_(seq.consumed()) {}
+
+        size_t offset(value_type const * ptr) const noexcept
+        {
+            return (ptr - sequence_.tail() + sequence_.bsize()) % sequence_.bsize();
+        }
+
+        /*
+         * pending is the number of already scanned bytes the current search state depends on
+         * @return true if the scan has to start over from the tail
+         */
+        bool is_stale(size_t pending) const noexcept
+        {
+            return !is_reachable() || (scanned_ - sequence_.consumed() < pending);
+        }
+
+        /*
+         * The tail has not passed the scan position within the same generation
+         */
+        bool is_reachable() const noexcept
+        {
+            return is_iter_up_to_date(generation_) && (scanned_ >= sequence_.consumed());
+        }
+
+        value_type * position() const noexcept
+        {
+            return sequence_.bbegin() + (sequence_.tail() - sequence_.bbegin() + (scanned_ - sequence_.consumed())) % sequence_.bsize();
+        }
+
+        void seek(value_type * ptr) noexcept
+        {
+            generation_ = sequence_.begin();
+            scanned_ = sequence_.consumed() + offset(ptr);
+        }
+
+        const_iterator back(value_type * ptr, size_t n) const noexcept
+        {
+            return const_iterator {&sequence_, sequence_.bbegin() + (ptr - sequence_.bbegin() + sequence_.bsize() - n) % sequence_.bsize()};
+        }
+    };
+
+    /**
+     * \brief Resumable sub-sequence search over a ring_buffer_sequence
+     *
+     * Remembers how far it has scanned and how much of the pattern is partially matched (KMP),
+     * so successive next() calls only examine data appended by fill_data in between.
+     * Falls back to a scan from the tail when the sequence was reset() (checked variant only)
+     * or when align() released the bytes of a partial match.
+     */
+    template <class Sequence>
+    class ring_searcher : private ring_scan_position<Sequence>
+    {
+        using base = ring_scan_position<Sequence>;
+        using base::sequence_;
+
+    public:
+        using typename base::const_iterator;
+        using typename base::value_type;
+
+    private:
+        std::vector<value_type> pattern_;
+        std::vector<size_t> failure_;
+        size_t matched_ = 0;
+
+    public:
+        template <class It>
+        ring_searcher(Sequence const & seq, It first, It last) : base(seq), pattern_(first, last), failure_(pattern_.size(), 0)
+        {
+            for (size_t i = 1, k = 0; i < pattern_.size(); ++i)
+            {
+                while (k && (pattern_[i] != pattern_[k]))
+                {
+                    k = failure_[k - 1];
+                }
+                if (pattern_[i] == pattern_[k])
+                {
+                    ++k;
+                }
+                failure_[i] = k;
+            }
+        }
+
+        /**
+         * Continues the search with the data appended since the previous call
+         * @return iterator to the start of the next match, or end() of the sequence if there is none yet
+         */
+        const_iterator next()
+        {
+            if (pattern_.empty())
+            {
+                return sequence_.begin();
+            }
+            if (this->is_stale(matched_))
+            {
+                this->seek(sequence_.tail());
+                matched_ = 0;
+            }
+
+            auto ptr = this->position();
+            auto const head = sequence_.head();
+            auto const bend = sequence_.bend();
+            while (ptr != head)
+            {
+                while (matched_ && (*ptr != pattern_[matched_]))
+                {
+                    matched_ = failure_[matched_ - 1];
+                }
+                if (*ptr == pattern_[matched_])
+                {
+                    ++matched_;
+                }
+                if (++ptr == bend)
+                {
+                    ptr = sequence_.bbegin();
+                }
+                if (matched_ == pattern_.size())
+                {
+                    matched_ = 0;
+                    this->seek(ptr);
+                    return this->back(ptr, pattern_.size());
+                }
+            }
+            this->seek(ptr);
+            return sequence_.end();
+        }
+    };
+
+    template <class Sequence, class It>
+    ring_searcher(Sequence const &, It, It) -> ring_searcher<Sequence>;
+
+    /**
+     * \brief Compiled multi-pattern automaton (Aho-Corasick) over byte-sized values
+     *
+     * Transitions are kept in one dense table of 256 entries per state, so a scan step is a single lookup.
+     */
+    template <class V>
+    class aho_corasick
+    {
+        static_assert(sizeof(V) == 1);
+        static constexpr size_t alphabet = 256;
+        static constexpr uint32_t none = ~uint32_t(0);
+
+        std::vector<uint32_t> goto_;        // dense transitions, alphabet entries per state
+        std::vector<uint32_t> depth_;       // length of the prefix a state stands for
+        std::vector<uint32_t> output_;      // last added pattern ending at a state, or none
+        std::vector<uint32_t> same_end_;    // previously added pattern ending at the same state (duplicates), or none
+        std::vector<uint32_t> dict_link_;   // nearest proper suffix state with an output, or none
+        std::vector<size_t> lengths_;
+
+        static size_t index(V v) noexcept
+        {
+            return static_cast<unsigned char>(v);
+        }
+
+        uint32_t add_state(uint32_t depth)
+        {
+            goto_.resize(goto_.size() + alphabet, none);
+            depth_.push_back(depth);
+            output_.push_back(none);
+            dict_link_.push_back(none);
+            return static_cast<uint32_t>(depth_.size() - 1);
+        }
+
+        template <class Pattern>
+        void add_pattern(Pattern const & pattern)
+        {
+            uint32_t state = 0;
+            for (auto v : pattern)
+            {
+                auto const transition = state * alphabet + index(v);
+                if (goto_[transition] == none)
+                {
+                    auto const created = add_state(depth_[state] + 1);
+                    goto_[transition] = created;
+                }
+                state = goto_[transition];
+            }
+            same_end_.push_back(output_[state]);
+            output_[state] = static_cast<uint32_t>(lengths_.size());
+            lengths_.push_back(depth_[state]);
+        }
+
+        void build()
+        {
+            std::vector<uint32_t> fail(depth_.size(), 0);
+            std::vector<uint32_t> queue;
+            queue.reserve(depth_.size());
+            for (size_t c = 0; c < alphabet; ++c)
+            {
+                auto & next = goto_[c];
+                if (next == none)
+                {
+                    next = 0;
+                } else
+                {
+                    queue.push_back(next);
+                }
+            }
+            for (size_t i = 0; i < queue.size(); ++i)
+            {
+                auto const state = queue[i];
+                auto const link = fail[state];
+                dict_link_[state] = (output_[link] != none) ? link : dict_link_[link];
+                for (size_t c = 0; c < alphabet; ++c)
+                {
+                    auto & next = goto_[state * alphabet + c];
+                    if (next == none)
+                    {
+                        next = goto_[link * alphabet + c];
+                    } else
+                    {
+                        fail[next] = goto_[link * alphabet + c];
+                        queue.push_back(next);
+                    }
+                }
+            }
+        }
+
+    public:
+        template <class Patterns>
+        explicit aho_corasick(Patterns const & patterns)
+        {
+            add_state(0);
+            for (auto const & pattern : patterns)
+            {
+                add_pattern(pattern);
+            }
+            build();
+        }
+
+        aho_corasick(std::initializer_list<std::basic_string_view<V>> patterns) : aho_corasick(std::vector<std::basic_string_view<V>>(patterns)) {}
+
+        [[nodiscard]] size_t patterns() const noexcept
+        {
+            return lengths_.size();
+        }
+
+        [[nodiscard]] size_t length(size_t pattern) const noexcept
+        {
+            return lengths_[pattern];
+        }
+
+        [[nodiscard]] uint32_t step(uint32_t state, V v) const noexcept
+        {
+            return goto_[state * alphabet + index(v)];
+        }
+
+        [[nodiscard]] uint32_t depth(uint32_t state) const noexcept
+        {
+            return depth_[state];
+        }
+
+        /*
+         * Calls on_match(pattern) for every pattern ending at the state, longest first
+         * (duplicate patterns latest added first)
+         */
+        template <class Fn>
+        void outputs(uint32_t state, Fn && on_match) const
+        {
+            if (output_[state] == none)
+            {
+                state = dict_link_[state];
+            }
+            while (state != none)
+            {
+                for (auto pattern = output_[state]; pattern != none; pattern = same_end_[pattern])
+                {
+                    on_match(pattern);
+                }
+                state = dict_link_[state];
+            }
+        }
+    };
+
+    /**
+     * \brief Resumable multi-pattern search over a ring_buffer_sequence
+     *
+     * Scans every appended byte once for all patterns of the automaton; the automaton state is carried
+     * across fill_data calls and the wrap point.
+     */
+    template <class Sequence>
+    class ring_multi_searcher : private ring_scan_position<Sequence>
+    {
+        using base = ring_scan_position<Sequence>;
+        using base::sequence_;
+
+    public:
+        using typename base::const_iterator;
+        using typename base::value_type;
+        using automaton_type = aho_corasick<typename std::remove_const<value_type>::type>;
+
+    private:
+        automaton_type const & automaton_;
+        uint32_t state_ = 0;
+
+    public:
+        ring_multi_searcher(Sequence const & seq, automaton_type const & automaton) : base(seq), automaton_(automaton) {}
+
+        /**
+         * Continues the search with the data appended since the previous call
+         * and calls on_match(const_iterator, pattern id) for every match, overlapping ones included
+         * @return number of matches reported
+         */
+        template <class Fn>
+        size_t scan(Fn && on_match)
+        {
+            auto const bend = sequence_.bend();
+            if (this->is_stale(automaton_.depth(state_)))
+            {
+                state_ = 0;
+                if (this->is_reachable())
+                {
+                    // align() cut into the current prefix: rebuild the state over the still scanned [tail, scanned) without reporting again
+                    for (auto ptr = sequence_.tail(); ptr != this->position(); ptr = (ptr + 1 == bend) ? sequence_.bbegin() : ptr + 1)
+                    {
+                        state_ = automaton_.step(state_, *ptr);
+                    }
+                } else
+                {
+                    this->seek(sequence_.tail());
+                }
+            }
+
+            size_t matches = 0;
+            auto ptr = this->position();
+            auto const head = sequence_.head();
+            while (ptr != head)
+            {
+                state_ = automaton_.step(state_, *ptr);
+                if (++ptr == bend)
+                {
+                    ptr = sequence_.bbegin();
+                }
+                automaton_.outputs(state_, [&](size_t pattern)
+                {
+                    ++matches;
+                    on_match(this->back(ptr, automaton_.length(pattern)), pattern);
+                });
+            }
+            this->seek(ptr);
+            return matches;
+        }
+    };
+}
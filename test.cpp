@@ -5,7 +5,15 @@
 #define BOOST_TEST_MODULE boost_test_module_
 #include <boost/test/unit_test.hpp> // UTF ??
 #include "ring_iter.h"
+#include "bit_iter.h"
+#include "ring_search.h"
+#include "ring_frame.h"
+#include "ring_broadcast.h"
+#include "ring_object.h"
+#include "ring_async.h"
+#include "ring_bit_iter.h"
 #include <iostream>
+#include <thread>
 
 using namespace funny_it;
 
@@ -274,3 +282,670 @@ BOOST_AUTO_TEST_CASE( ring_iterator_overflow_test )
     BOOST_REQUIRE_NO_THROW(rbs.fill_data(external_buffer, 1));
     BOOST_REQUIRE_THROW(rbs.fill_data(external_buffer, 1), typename decltype(rbs)::overflow_exception);
 }
+
+BOOST_AUTO_TEST_CASE( ring_iterator_full_policies_test )
+{
+    char external_buffer[6] = {0x31,0x32,0x33,0x34,0x35,0x36};
+    {
+        std::array<char,10> std_array {};
+        ring_buffer_sequence<char, 10, exception_checked_variant_type, full_reject_variant_type> rbs (std_array);
+        BOOST_REQUIRE_EQUAL(rbs.fill_data(external_buffer, sizeof(external_buffer)), 6);
+        BOOST_REQUIRE_EQUAL(rbs.fill_data(external_buffer, sizeof(external_buffer)), 3);
+        BOOST_REQUIRE_EQUAL(rbs.size(), 9);
+        BOOST_REQUIRE_EQUAL(rbs.fill_data(external_buffer, 1), 0);
+        BOOST_REQUIRE (std::string(rbs.begin(), rbs.end()) == "123456123");
+    }
+    {
+        std::array<char,10> std_array {};
+        ring_buffer_sequence<char, 10, exception_checked_variant_type, full_overwrite_variant_type> rbs (std_array);
+        rbs.fill_data(external_buffer, sizeof(external_buffer));
+        auto const outdated = rbs.begin();
+        BOOST_REQUIRE_EQUAL(rbs.fill_data(external_buffer, sizeof(external_buffer)), 6);
+        BOOST_REQUIRE_EQUAL(rbs.size(), 9);
+        BOOST_REQUIRE (std::string(rbs.begin(), rbs.end()) == "456123456");
+        using iter_type = typename decltype(rbs)::const_iterator;
+        BOOST_REQUIRE_THROW(*outdated, outdated_iterator<iter_type>);
+
+        char long_buffer[12] = {'a','b','c','d','e','f','g','h','i','j','k','l'};
+        BOOST_REQUIRE_EQUAL(rbs.fill_data(long_buffer, sizeof(long_buffer)), 12);
+        BOOST_REQUIRE (std::string(rbs.begin(), rbs.end()) == "defghijkl");
+    }
+    {
+        std::array<char,10> std_array {};
+        ring_buffer_sequence<char, 10, exception_checked_variant_type, full_block_variant_type> rbs (std_array);
+        rbs.fill_data(external_buffer, sizeof(external_buffer));
+        std::thread producer ([&] { rbs.fill_data(external_buffer, sizeof(external_buffer)); });
+        while (rbs.size() != 9)
+        {
+            std::this_thread::yield();
+        }
+        rbs.align();
+        producer.join();
+        BOOST_REQUIRE_EQUAL(rbs.size(), 3);
+        BOOST_REQUIRE (std::string(rbs.begin(), rbs.end()) == "456");
+    }
+    {
+        std::array<char,10> std_array {};
+        ring_buffer_sequence<char, 10, exception_checked_variant_type, full_block_variant_type> rbs (std_array);
+        static_assert(!noexcept(rbs.align()));
+        rbs.fill_data(external_buffer, sizeof(external_buffer));
+        std::thread producer ([&] { rbs.fill_data(external_buffer, sizeof(external_buffer)); });
+        while (rbs.size() != 9)
+        {
+            std::this_thread::yield();
+        }
+        // emptying the ring through reset() must wake the blocked producer too
+        auto const head = rbs.end();
+        rbs.reset(head, head);
+        producer.join();
+        BOOST_REQUIRE_EQUAL(rbs.size(), 3);
+        BOOST_REQUIRE (std::string(rbs.begin(), rbs.end()) == "456");
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ring_iterator_drain_test )
+{
+    char c_array[10] {};
+    ring_buffer_sequence rbs (c_array);
+    make_rotated_sequence (rbs);
+
+    char out[10] {};
+    BOOST_REQUIRE_EQUAL(rbs.peek(out, 4), 4);
+    BOOST_REQUIRE (std::string(out, 4) == "1234");
+    BOOST_REQUIRE_EQUAL(rbs.size(), 6);
+
+    // copy across the wrap point
+    BOOST_REQUIRE_EQUAL(rbs.drain(out, 5), 5);
+    BOOST_REQUIRE (std::string(out, 5) == "12345");
+    BOOST_REQUIRE_EQUAL(rbs.size(), 1);
+    BOOST_REQUIRE (*rbs.begin() == '6');
+
+    std::array<char, 4> dest {};
+    BOOST_REQUIRE_EQUAL(rbs.consume_into(dest), 1);
+    BOOST_REQUIRE_EQUAL(dest[0], '6');
+    BOOST_REQUIRE_EQUAL(rbs.size(), 0);
+    BOOST_REQUIRE_EQUAL(rbs.drain(out, sizeof(out)), 0);
+}
+
+BOOST_AUTO_TEST_CASE( ring_searcher_trickle_test )
+{
+    std::array<char,10> std_array {};
+    ring_buffer_sequence rbs (std_array);
+    std::array<char, 2> delimiter {'\r', '\n'};
+    ring_searcher searcher (rbs, delimiter.begin(), delimiter.end());
+
+    char const input[] = "foo\r\nbar\r\n";
+    auto it = rbs.end();
+    // trickle byte by byte: the partial "\r" survives between calls
+    for (size_t i = 0; i < 5; ++i)
+    {
+        BOOST_REQUIRE (it == std::end(rbs));
+        rbs.fill_data(input + i, 1);
+        it = searcher.next();
+    }
+    BOOST_REQUIRE (it != std::end(rbs));
+    BOOST_REQUIRE (std::string(rbs.begin(), it) == "foo");
+    rbs.align(it + 2);
+
+    // the second message wraps around the end of the buffer
+    for (size_t i = 5; i < 10; ++i)
+    {
+        rbs.fill_data(input + i, 1);
+        it = searcher.next();
+    }
+    BOOST_REQUIRE (it != std::end(rbs));
+    BOOST_REQUIRE (rbs.head() < rbs.tail());
+    BOOST_REQUIRE (std::string(rbs.begin(), it) == "bar");
+    rbs.align(it + 2);
+    BOOST_REQUIRE (searcher.next() == std::end(rbs));
+
+    // a partial match dropped by align() is not resumed
+    rbs.fill_data(input + 3, 1);
+    BOOST_REQUIRE (searcher.next() == std::end(rbs));
+    rbs.align();
+    rbs.fill_data(input + 4, 1);
+    BOOST_REQUIRE (searcher.next() == std::end(rbs));
+
+    // reset() starts the scan over from the new tail
+    rbs.fill_data(input + 3, 1);
+    BOOST_REQUIRE (searcher.next() == std::end(rbs));
+    rbs.reset(rbs.begin(), ++rbs.begin());
+    rbs.fill_data(input + 4, 1);
+    BOOST_REQUIRE (searcher.next() == std::end(rbs));
+    rbs.fill_data(input + 3, 2);
+    BOOST_REQUIRE ((it = searcher.next()) != std::end(rbs));
+    BOOST_REQUIRE_EQUAL (rbs.distance(rbs.begin(), it), 2);
+
+    // the head wrapping over the scan position after align() does not hide unscanned data
+    for (bool scanned_before_align : {false, true})
+    {
+        std::array<char,10> wrap_array {};
+        ring_buffer_sequence wrapped (wrap_array);
+        ring_searcher x_searcher (wrapped, "X", "X" + 1);
+        wrapped.fill_data("abcde", 5);
+        if (scanned_before_align)
+        {
+            BOOST_REQUIRE (x_searcher.next() == std::end(wrapped));
+        }
+        wrapped.align();
+        wrapped.fill_data("abXdefg", 7);
+        BOOST_REQUIRE (wrapped.head() < wrapped.tail());
+        BOOST_REQUIRE ((it = x_searcher.next()) != std::end(wrapped));
+        BOOST_REQUIRE_EQUAL (wrapped.distance(wrapped.begin(), it), 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ring_multi_searcher_test )
+{
+    std::array<char,10> std_array {};
+    ring_buffer_sequence rbs (std_array);
+    aho_corasick<char> const automaton {"he", "she", "his", "hers"};
+    BOOST_REQUIRE_EQUAL(automaton.patterns(), 4);
+    ring_multi_searcher searcher (rbs, automaton);
+
+    std::vector<std::pair<std::string, size_t>> found;
+    auto const collect = [&](auto it, size_t pattern)
+    {
+        found.emplace_back(std::string(it, it + automaton.length(pattern)), pattern);
+    };
+
+    char const input[] = "ushers";
+    rbs.fill_data(input, 3);
+    BOOST_REQUIRE_EQUAL(searcher.scan(collect), 0);
+    rbs.fill_data(input + 3, 3);
+    BOOST_REQUIRE_EQUAL(searcher.scan(collect), 3);
+    BOOST_REQUIRE (found[0] == std::make_pair(std::string("she"), size_t(1)));
+    BOOST_REQUIRE (found[1] == std::make_pair(std::string("he"), size_t(0)));
+    BOOST_REQUIRE (found[2] == std::make_pair(std::string("hers"), size_t(3)));
+
+    // state is carried over the wrap point
+    rbs.align();
+    found.clear();
+    rbs.fill_data("xxhi", 4);
+    BOOST_REQUIRE_EQUAL(searcher.scan(collect), 0);
+    rbs.fill_data("s", 1);
+    BOOST_REQUIRE (rbs.head() < rbs.tail());
+    BOOST_REQUIRE_EQUAL(searcher.scan(collect), 1);
+    BOOST_REQUIRE (found[0] == std::make_pair(std::string("his"), size_t(2)));
+
+    // align() cutting into the current prefix does not report earlier matches again
+    std::array<char,10> other_array {};
+    ring_buffer_sequence other (other_array);
+    aho_corasick<char> const nested {"abcd", "c"};
+    ring_multi_searcher nested_searcher (other, nested);
+    other.fill_data("abc", 3);
+    BOOST_REQUIRE_EQUAL(nested_searcher.scan([](auto, size_t) {}), 1);
+    other.align(other.begin() + 1);
+    BOOST_REQUIRE_EQUAL(nested_searcher.scan([](auto, size_t) {}), 0);
+    other.fill_data("d", 1);
+    BOOST_REQUIRE_EQUAL(nested_searcher.scan([](auto, size_t) {}), 0);
+    other.fill_data("c", 1);
+    BOOST_REQUIRE_EQUAL(nested_searcher.scan([](auto, size_t) {}), 1);
+
+    // the head wrapping over the scan position after align() does not hide unscanned data
+    for (bool scanned_before_align : {false, true})
+    {
+        std::array<char,10> wrap_array {};
+        ring_buffer_sequence wrapped (wrap_array);
+        aho_corasick<char> const markers {"X", "ab"};
+        ring_multi_searcher wrap_searcher (wrapped, markers);
+        wrapped.fill_data("abcde", 5);
+        if (scanned_before_align)
+        {
+            BOOST_REQUIRE_EQUAL(wrap_searcher.scan([](auto, size_t) {}), 1);
+        }
+        wrapped.align();
+        wrapped.fill_data("abXdefg", 7);
+        BOOST_REQUIRE (wrapped.head() < wrapped.tail());
+        std::vector<std::pair<size_t, size_t>> hits;
+        BOOST_REQUIRE_EQUAL(wrap_searcher.scan([&](auto it, size_t pattern) { hits.emplace_back(wrapped.distance(wrapped.begin(), it), pattern); }), 2);
+        BOOST_REQUIRE (hits == (std::vector<std::pair<size_t, size_t>> {{0, 1}, {2, 0}}));
+    }
+
+    // a pattern added twice is reported under both ids
+    aho_corasick<char> const duplicates {"ab", "b", "ab"};
+    ring_multi_searcher duplicates_searcher (other, duplicates);
+    other.align();
+    other.fill_data("ab", 2);
+    std::vector<size_t> ids;
+    BOOST_REQUIRE_EQUAL(duplicates_searcher.scan([&](auto, size_t pattern) { ids.push_back(pattern); }), 3);
+    std::sort(ids.begin(), ids.end());
+    BOOST_REQUIRE (ids == std::vector<size_t>({0, 1, 2}));
+}
+
+template <class Message>
+static std::string message_string (Message const & message)
+{
+    std::string ret (message.first, message.first_size);
+    if (!message.contiguous())
+    {
+        ret.append(message.second, message.second_size);
+    }
+    return ret;
+}
+
+BOOST_AUTO_TEST_CASE( ring_framer_test )
+{
+    {
+        std::array<char,10> std_array {};
+        ring_buffer_sequence rbs (std_array);
+        ring_framer framer (rbs, length_prefix_framing<2>{});
+        rbs.fill_data("\0\3ab", 4);
+        BOOST_REQUIRE (!framer.next());
+        rbs.fill_data("c\0\0", 3);
+        auto const first = framer.next();
+        auto const second = framer.next();
+        BOOST_REQUIRE (first && second);
+        BOOST_REQUIRE (first->contiguous());
+        BOOST_REQUIRE (message_string(*first) == "abc");
+        BOOST_REQUIRE (message_string(*second).empty());
+        BOOST_REQUIRE (!framer.next());
+        framer.release(*first);
+        BOOST_REQUIRE_EQUAL (rbs.size(), 2);
+        framer.release(*second);
+        BOOST_REQUIRE_EQUAL (rbs.size(), 0);
+
+        // payload split by the wrap point
+        rbs.fill_data("\0\4wxyz", 6);
+        auto const wrapped = framer.next();
+        BOOST_REQUIRE (wrapped && !wrapped->contiguous());
+        BOOST_REQUIRE (message_string(*wrapped) == "wxyz");
+        framer.release(*wrapped);
+        BOOST_REQUIRE_EQUAL (rbs.size(), 0);
+
+        rbs.fill_data("\0\11", 2);
+        BOOST_REQUIRE_THROW(framer.next(), oversized_frame);
+    }
+    {
+        // a length that would wrap size_t once the header size is added
+        std::array<char,16> std_array {};
+        ring_buffer_sequence rbs (std_array);
+        ring_framer framer (rbs, length_prefix_framing<8>{});
+        rbs.fill_data("\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xF9", 8);
+        BOOST_REQUIRE_THROW(framer.next(), oversized_frame);
+    }
+    {
+        // a frame that fits the ring is not oversized while an earlier message is held
+        std::array<char,10> std_array {};
+        ring_buffer_sequence rbs (std_array);
+        ring_framer framer (rbs, length_prefix_framing<1>{});
+        rbs.fill_data("\3abc\5de", 7);
+        auto const held = framer.next();
+        BOOST_REQUIRE (held);
+        BOOST_REQUIRE (!framer.next());
+        framer.release(*held);
+        rbs.fill_data("fgh", 3);
+        auto const second = framer.next();
+        BOOST_REQUIRE (second);
+        BOOST_REQUIRE (message_string(*second) == "defgh");
+    }
+    {
+        // varint length overflowing size_t
+        std::array<char,16> std_array {};
+        ring_buffer_sequence rbs (std_array);
+        ring_framer framer (rbs, varint_framing{});
+        rbs.fill_data("\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x7F", 10);
+        BOOST_REQUIRE_THROW(framer.next(), malformed_header);
+    }
+    {
+        std::array<char,10> std_array {};
+        ring_buffer_sequence rbs (std_array);
+        ring_framer framer (rbs, varint_framing{});
+        rbs.fill_data("\2hi\1!", 5);
+        auto const first = framer.next();
+        auto const second = framer.next();
+        BOOST_REQUIRE (first && second);
+        BOOST_REQUIRE (message_string(*first) == "hi");
+        BOOST_REQUIRE (message_string(*second) == "!");
+        framer.release(*second);
+        BOOST_REQUIRE_EQUAL (rbs.size(), 0);
+
+        rbs.fill_data("\x80\x80", 2);
+        BOOST_REQUIRE (!framer.next());
+    }
+    {
+        std::array<char,10> std_array {};
+        ring_buffer_sequence rbs (std_array);
+        std::string_view const delimiter {"\r\n"};
+        ring_framer framer (rbs, delimiter_framing(rbs, delimiter.begin(), delimiter.end()));
+        rbs.fill_data("foo\r\nba", 7);
+        auto const first = framer.next();
+        BOOST_REQUIRE (first);
+        BOOST_REQUIRE (message_string(*first) == "foo");
+        BOOST_REQUIRE (!framer.next());
+        framer.release(*first);
+        rbs.fill_data("r\r\n", 3);
+        auto const second = framer.next();
+        BOOST_REQUIRE (second);
+        BOOST_REQUIRE (message_string(*second) == "bar");
+        framer.release(*second);
+        BOOST_REQUIRE_EQUAL (rbs.size(), 0);
+    }
+    {
+        // no delimiter while the frame fills the whole ring
+        std::array<char,10> std_array {};
+        ring_buffer_sequence rbs (std_array);
+        std::string_view const delimiter {"\r\n"};
+        ring_framer framer (rbs, delimiter_framing(rbs, delimiter.begin(), delimiter.end()));
+        rbs.fill_data("ab\r\ncdefg", 9);
+        auto const held = framer.next();
+        BOOST_REQUIRE (held);
+        // a full ring is not proof of an oversized frame while an earlier message is held
+        BOOST_REQUIRE (!framer.next());
+        framer.release(*held);
+        rbs.fill_data("hij", 3);
+        BOOST_REQUIRE (!framer.next());
+        rbs.fill_data("k", 1);
+        BOOST_REQUIRE_THROW(framer.next(), oversized_frame);
+
+        std::array<char,10> other_array {};
+        ring_buffer_sequence other (other_array);
+        ring_framer other_framer (other, delimiter_framing(other, delimiter.begin(), delimiter.end()));
+        other.fill_data("abcdefghi", 9);
+        BOOST_REQUIRE_THROW(other_framer.next(), oversized_frame);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( broadcast_ring_test )
+{
+    std::array<char,10> std_array {};
+    broadcast_ring<char, 10, 2> ring (std_array);
+    char external_buffer[6] = {0x31,0x32,0x33,0x34,0x35,0x36};
+    auto logger = ring.subscribe();
+    {
+        auto parser = ring.subscribe();
+        BOOST_REQUIRE_THROW(ring.subscribe(), no_reader_slot);
+
+        BOOST_REQUIRE_EQUAL(ring.fill_data(external_buffer, sizeof(external_buffer)), 6);
+        BOOST_REQUIRE_EQUAL(logger.size(), 0);
+        BOOST_REQUIRE_EQUAL(logger.refresh(), 6);
+        BOOST_REQUIRE_EQUAL(parser.refresh(), 6);
+
+        // readers consume independently
+        auto const it = std::find (parser.begin(), parser.end(), '4');
+        BOOST_REQUIRE (std::string(parser.begin(), it) == "123");
+        parser.align(it);
+        BOOST_REQUIRE_EQUAL(parser.size(), 3);
+        BOOST_REQUIRE_EQUAL(logger.size(), 6);
+
+        // the producer is gated by the slowest reader
+        BOOST_REQUIRE_EQUAL(ring.fill_data(external_buffer, sizeof(external_buffer)), 3);
+        logger.align();
+        BOOST_REQUIRE_EQUAL(ring.fill_data(external_buffer, sizeof(external_buffer)), 3);
+        BOOST_REQUIRE_EQUAL(ring.fill_data(external_buffer, sizeof(external_buffer)), 0);
+        BOOST_REQUIRE_EQUAL(parser.refresh(), 9);
+        char out[10] {};
+        BOOST_REQUIRE_EQUAL(parser.drain(out, sizeof(out)), 9);
+        BOOST_REQUIRE (std::string(out, 9) == "456123123");
+        BOOST_REQUIRE_EQUAL(ring.fill_data(external_buffer, sizeof(external_buffer)), 3);
+    }
+    // an unsubscribed reader does not gate the producer
+    BOOST_REQUIRE_EQUAL(logger.refresh(), 9);
+    BOOST_REQUIRE (std::string(logger.begin(), logger.end()) == "123123123");
+    logger.align();
+    BOOST_REQUIRE_EQUAL(ring.fill_data(external_buffer, sizeof(external_buffer)), 6);
+    BOOST_REQUIRE_EQUAL(logger.refresh(), 6);
+    auto parser = ring.subscribe();
+    BOOST_REQUIRE_EQUAL(parser.refresh(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( object_ring_test )
+{
+    auto const counter = std::make_shared<int>(0);
+    {
+        object_ring<std::pair<std::shared_ptr<int>, std::string>, 4> ring;
+        BOOST_REQUIRE (ring.empty());
+        ring.emplace_back(counter, "first");
+        ring.push({counter, "second"});
+        ring.emplace_back(counter, "third");
+        BOOST_REQUIRE_EQUAL (counter.use_count(), 4);
+        BOOST_REQUIRE_THROW (ring.emplace_back(counter, "overflow"), typename decltype(ring)::overflow_exception);
+        BOOST_REQUIRE_EQUAL (counter.use_count(), 4);
+
+        BOOST_REQUIRE (ring.front().second == "first");
+        ring.pop_front();
+        BOOST_REQUIRE_EQUAL (counter.use_count(), 3);
+
+        // construction wraps around the end of the storage
+        ring.emplace_back(counter, "fourth");
+        auto const it = std::find_if (ring.begin(), ring.end(), [](auto const & elem) { return elem.second == "fourth"; });
+        BOOST_REQUIRE (it != std::end(ring));
+        ring.align(it);
+        BOOST_REQUIRE_EQUAL (ring.size(), 1);
+        BOOST_REQUIRE_EQUAL (counter.use_count(), 2);
+
+        std::pair<std::shared_ptr<int>, std::string> out[2];
+        BOOST_REQUIRE_EQUAL (ring.drain(out, 2), 1);
+        BOOST_REQUIRE (out[0].second == "fourth");
+        BOOST_REQUIRE (ring.empty());
+        BOOST_REQUIRE_EQUAL (counter.use_count(), 2);
+
+        ring.emplace_back(counter, "left over");
+    }
+    // the destructor releases what is left in the ring
+    BOOST_REQUIRE_EQUAL (counter.use_count(), 1);
+
+    object_ring<int, 4> ints;
+    int const values[] = {1, 2, 3};
+    ints.fill_data(values, 2);
+    ints.pop_front();
+    ints.fill_data(values, 2);
+    BOOST_REQUIRE (std::vector<int>(ints.begin(), ints.end()) == std::vector<int>({2, 1, 2}));
+    BOOST_REQUIRE_THROW (ints.fill_data(values, 1), typename decltype(ints)::overflow_exception);
+}
+
+BOOST_AUTO_TEST_CASE( ring_view_sentinel_test )
+{
+    char c_array[10] {};
+    ring_buffer_sequence rbs (c_array);
+    make_rotated_sequence (rbs);
+
+    std::string collected;
+    for (auto c : rbs.view())
+    {
+        collected += c;
+    }
+    BOOST_REQUIRE (collected == "123456");
+    BOOST_REQUIRE (rbs.view().end() == rbs.end());
+    BOOST_REQUIRE (rbs.begin() != rbs.view().end());
+    // the view steps a bare pointer: no generation or sequence pointer is carried along
+    static_assert (sizeof(decltype(rbs.view().begin())) == 3 * sizeof(char *));
+    auto last = rbs.view().begin();
+    for (size_t i = 0; i < 5; ++i)
+    {
+        ++last;
+    }
+    BOOST_REQUIRE (*last == '6');
+    BOOST_REQUIRE (++last == rbs.view().end());
+
+#if defined(__cpp_lib_ranges)
+    static_assert (std::ranges::forward_range<decltype(rbs.view())>);
+    static_assert (std::ranges::borrowed_range<decltype(rbs.view())>);
+    static_assert (std::ranges::view<decltype(rbs.view())>);
+    auto evens = rbs.view() | std::views::filter([](char c) { return c % 2 == 0; });
+    BOOST_REQUIRE_EQUAL (std::ranges::distance(evens), 3);
+    BOOST_REQUIRE (*std::ranges::find(rbs.view(), '5') == '5');
+#endif
+}
+
+BOOST_AUTO_TEST_CASE( ring_stats_test )
+{
+    char external_buffer[6] = {0x31,0x32,0x33,0x34,0x35,0x36};
+    {
+        std::array<char,10> std_array {};
+        ring_buffer_sequence<char, 10, exception_checked_variant_type, full_reject_variant_type, ring_stats_enabled_variant_type> rbs (std_array);
+        rbs.fill_data(external_buffer, sizeof(external_buffer));
+        rbs.align(rbs.begin() + 2);
+        rbs.fill_data(external_buffer, sizeof(external_buffer));
+        rbs.reset(rbs.begin() + 1, rbs.end());
+        char out[4] {};
+        rbs.drain(out, sizeof(out));
+        rbs.align();
+
+        auto const stats = rbs.stats();
+        BOOST_REQUIRE_EQUAL (stats.fills, 2);
+        BOOST_REQUIRE_EQUAL (stats.bytes_in, 11);
+        BOOST_REQUIRE_EQUAL (stats.overflows, 1);
+        BOOST_REQUIRE_EQUAL (stats.high_water, 9);
+        BOOST_REQUIRE_EQUAL (stats.aligns, 3);
+        BOOST_REQUIRE_EQUAL (stats.bytes_out, 10);
+        BOOST_REQUIRE_EQUAL (stats.generations, 1);
+    }
+    {
+        // input longer than the capacity drops its leading bytes even into an empty ring
+        std::array<char,10> std_array {};
+        ring_buffer_sequence<char, 10, exception_checked_variant_type, full_overwrite_variant_type, ring_stats_enabled_variant_type> rbs (std_array);
+        char long_buffer[12] {};
+        rbs.fill_data(long_buffer, sizeof(long_buffer));
+        BOOST_REQUIRE_EQUAL (rbs.stats().overflows, 1);
+        rbs.fill_data(long_buffer, 1);
+        BOOST_REQUIRE_EQUAL (rbs.stats().overflows, 2);
+        BOOST_REQUIRE_EQUAL (rbs.stats().generations, 1);
+    }
+    {
+        // generations are counted whether or not iterators are checked
+        std::array<char,10> std_array {};
+        ring_buffer_sequence<char, 10, exception_unchecked_variant_type, full_throw_variant_type, ring_stats_enabled_variant_type> rbs (std_array);
+        rbs.fill_data(external_buffer, sizeof(external_buffer));
+        rbs.reset(rbs.begin() + 1, rbs.end());
+        rbs.reset(rbs.begin(), rbs.end());
+        BOOST_REQUIRE_EQUAL (rbs.stats().generations, 1);
+    }
+    {
+        char c_array[10] {};
+        ring_buffer_sequence rbs (c_array);
+        make_rotated_sequence (rbs);
+        BOOST_REQUIRE_EQUAL (rbs.stats().fills, 0);
+    }
+
+    bit_sequence<2, bit_stats_enabled_variant_type> seq {std::array<std::byte, 2>{std::byte{3}, std::byte{1}}};
+    BOOST_REQUIRE_EQUAL (std::count(seq.begin(), seq.end(), std::byte{1}), 3);
+    BOOST_REQUIRE_EQUAL (seq.stats().begin_calls, 1);
+    static_assert (sizeof(bit_sequence<2>) == 2);
+}
+
+BOOST_AUTO_TEST_CASE( async_ring_test )
+{
+    ring_executor executor;
+    std::array<char,10> std_array {};
+    ring_buffer_sequence rbs (std_array);
+    async_ring ring (rbs, executor);
+
+    std::vector<std::string> received;
+    auto consumer = [&]() -> ring_task
+    {
+        BOOST_REQUIRE_EQUAL (co_await ring.readable(3), 5);
+        char header[3] {};
+        rbs.drain(header, sizeof(header));
+        received.emplace_back(header, sizeof(header));
+
+        auto const it = co_await ring.until("\r\n");
+        received.emplace_back(rbs.begin(), it);
+        rbs.align(it + 2);
+    };
+    executor.spawn(consumer());
+    BOOST_REQUIRE_EQUAL (executor.run(), 1);
+
+    ring.fill_data("ab", 2);
+    BOOST_REQUIRE_EQUAL (executor.run(), 0);
+    ring.fill_data("cfo", 3);
+    BOOST_REQUIRE_EQUAL (executor.run(), 1);
+    BOOST_REQUIRE_EQUAL (received.size(), 1);
+    BOOST_REQUIRE (received[0] == "abc");
+
+    ring.fill_data("o\r", 2);
+    BOOST_REQUIRE_EQUAL (executor.run(), 0);
+    ring.fill_data("\n", 1);
+    BOOST_REQUIRE_EQUAL (executor.run(), 1);
+    BOOST_REQUIRE_EQUAL (received.size(), 2);
+    BOOST_REQUIRE (received[1] == "foo");
+    BOOST_REQUIRE_EQUAL (rbs.size(), 0);
+
+    // exceptions escaping a task surface from run()
+    auto failing = [&]() -> ring_task
+    {
+        co_await ring.readable(1);
+        throw std::runtime_error("failed");
+    };
+    executor.spawn(failing());
+    executor.run();
+    ring.fill_data("x", 1);
+    BOOST_REQUIRE_THROW (executor.run(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( async_ring_destroyed_consumer_test )
+{
+    std::array<char,10> std_array {};
+    ring_buffer_sequence rbs (std_array);
+    {
+        auto executor = std::make_unique<ring_executor>();
+        async_ring ring (rbs, *executor);
+        bool resumed = false;
+        auto consumer = [&]() -> ring_task
+        {
+            co_await ring.until(std::string_view("\r\n"));
+            resumed = true;
+        };
+        executor->spawn(consumer());
+        executor->run();
+
+        // the suspended consumer goes away with its executor and must not be woken up
+        executor.reset();
+        BOOST_REQUIRE_NO_THROW (ring.fill_data("\r\n", 2));
+        BOOST_REQUIRE (!resumed);
+    }
+    {
+        // the ring goes away first, the suspended consumer is destroyed afterwards
+        ring_executor executor;
+        auto ring = std::make_unique<async_ring<decltype(rbs)>>(rbs, executor);
+        auto consumer = [&]() -> ring_task
+        {
+            co_await ring->readable(100);
+        };
+        executor.spawn(consumer());
+        executor.run();
+        ring.reset();
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ring_bit_view_test )
+{
+    std::array<char,6> std_array {};
+    ring_buffer_sequence rbs (std_array);
+    char const prefix[4] {};
+    rbs.fill_data(prefix, sizeof(prefix));
+    rbs.align();
+    char const bytes[3] = {0x0A, 0x0B, 0x0C}; // 00001010  00001011  00001100, the last two bytes wrapped
+    rbs.fill_data(bytes, sizeof(bytes));
+    BOOST_REQUIRE (rbs.head() < rbs.tail());
+
+    ring_bit_view bits (rbs);
+    BOOST_REQUIRE_EQUAL (bits.size(), 24);
+    BOOST_REQUIRE_EQUAL (std::count(bits.begin(), bits.end(), std::byte{1}), 7);
+    BOOST_REQUIRE_EQUAL (std::distance(bits.begin(), bits.end()), 24);
+
+    // search for 2 consequent "1" bits: 00001010 000010|11| 00001100
+    std::array<std::byte,2> ar {std::byte(1), std::byte(1)};
+    auto const it = std::search(bits.begin(), bits.end(), ar.begin(), ar.end());
+    BOOST_REQUIRE_EQUAL (it.offset(), 8);
+
+    BOOST_REQUIRE_EQUAL (bits.read_bits(0, 24), 0x0C0B0A);
+    BOOST_REQUIRE_EQUAL (bits.read_bits(4, 12), 0x0B0);
+    BOOST_REQUIRE_EQUAL (bits.read_bits(it, 3), 0x3);
+
+    // whole consumed bytes go back to the ring
+    rbs.align(bits.release_point(std::next(it, 10)));
+    BOOST_REQUIRE_EQUAL (rbs.size(), 1);
+    BOOST_REQUIRE_EQUAL (*rbs.begin(), 0x0C);
+
+    // 64 bit reads over the wrap point
+    std::array<char,12> wide_array {};
+    ring_buffer_sequence wide (wide_array);
+    wide.fill_data(prefix, 3);
+    wide.align();
+    char const word[10] = {0x01, 0x23, 0x45, 0x67, char(0x89), char(0xAB), char(0xCD), char(0xEF), 0x7F, 0x00};
+    wide.fill_data(word, sizeof(word));
+    ring_bit_view wide_bits (wide);
+    BOOST_REQUIRE_EQUAL (wide_bits.read_bits(0, 64), 0xEFCDAB8967452301ull);
+    BOOST_REQUIRE_EQUAL (wide_bits.read_bits(4, 64), 0xFEFCDAB896745230ull);
+}